@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+#include "stencil.hpp"
+
+namespace polysche
+{
+
+/** @brief Band matrix in the LAPACK band storage
+ *
+ * The element (i, j) of the n x n matrix, with -kl <= i - j <= ku, is stored in
+ * ab[(kl + ku + i - j) + j * ldab()] (column-major), the first kl rows of the storage being
+ * reserved for the fill-in of the LU factorization with partial pivoting (as for dgbtrf).
+ */
+template <typename Value>
+struct BandedMatrix
+{
+    std::size_t n = 0; ///< Size of the matrix
+    std::size_t kl = 0; ///< Number of sub-diagonals
+    std::size_t ku = 0; ///< Number of super-diagonals
+    std::vector<Value> ab; ///< Band storage
+
+    BandedMatrix() = default;
+
+    /// Null matrix of the given size and bandwidths
+    BandedMatrix(std::size_t n, std::size_t kl, std::size_t ku)
+        : n(n), kl(kl), ku(ku), ab((2 * kl + ku + 1) * n, Value(0))
+    {
+    }
+
+    /// Leading dimension of the storage
+    constexpr std::size_t ldab() const noexcept
+    {
+        return 2 * kl + ku + 1;
+    }
+
+    /// Element (i, j), that must be inside the band (or its fill-in)
+    Value& operator() (std::size_t i, std::size_t j) noexcept
+    {
+        return ab[kl + ku + i - j + j * ldab()];
+    }
+
+    Value const& operator() (std::size_t i, std::size_t j) const noexcept
+    {
+        return ab[kl + ku + i - j + j * ldab()];
+    }
+
+    /// y = A x (before factorization)
+    void multiply(Value const* x, Value* y) const noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::size_t const first = (i > kl) ? i - kl : 0;
+            std::size_t const last = (i + ku < n) ? i + ku : n - 1;
+            Value r = Value(0);
+            for (std::size_t j = first; j <= last; ++j)
+                r += (*this)(i, j) * x[j];
+            y[i] = r;
+        }
+    }
+};
+
+/** @brief Sparse matrix in the compressed sparse row (CSR) format
+ *
+ * The non-zero elements of the row i are values[k] at the columns col_index[k]
+ * for k in [row_ptr[i], row_ptr[i + 1][.
+ */
+template <typename Value>
+struct CsrMatrix
+{
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::vector<std::size_t> row_ptr; ///< Start of each row (rows + 1 values)
+    std::vector<std::size_t> col_index;
+    std::vector<Value> values;
+
+    /// Number of stored elements
+    std::size_t size() const noexcept
+    {
+        return values.size();
+    }
+
+    /// y = A x
+    void multiply(Value const* x, Value* y) const noexcept
+    {
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            Value r = Value(0);
+            for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                r += values[k] * x[col_index[k]];
+            y[i] = r;
+        }
+    }
+};
+
+namespace detail
+{
+
+/** @brief Stencil of the row i of an operator of size n
+ *
+ * The first rows use the one-sided stencils @p left, the last rows the stencils @p right
+ * (right[0] being the last row), and the other rows the interior stencil.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+Stencil<Value, N> const& row_stencil(Stencil<Value, N> const& interior, std::vector<Stencil<Value, N>> const& left,
+                                     std::vector<Stencil<Value, N>> const& right, std::size_t n, std::size_t i) noexcept
+{
+    if (i < left.size())
+        return left[i];
+    if (n - 1 - i < right.size())
+        return right[n - 1 - i];
+    return interior;
+}
+
+/// Bandwidths (kl, ku) of an operator of size n
+template <
+    typename Value,
+    std::size_t N
+>
+std::pair<std::size_t, std::size_t> bandwidths(Stencil<Value, N> const& interior, std::vector<Stencil<Value, N>> const& left,
+                                                std::vector<Stencil<Value, N>> const& right, std::size_t n) noexcept
+{
+    std::ptrdiff_t kl = 0, ku = 0;
+    auto update = [&] (Stencil<Value, N> const& S) {
+        kl = std::max<std::ptrdiff_t>(kl, -S.first);
+        ku = std::max<std::ptrdiff_t>(ku, S.last());
+    };
+
+    update(interior);
+    for (std::size_t i = 0; i < left.size() and i < n; ++i)
+        update(left[i]);
+    for (std::size_t i = 0; i < right.size() and i < n; ++i)
+        update(right[i]);
+    return {static_cast<std::size_t>(kl), static_cast<std::size_t>(ku)};
+}
+
+} // namespace detail
+
+/** @brief Assembles the band matrix of an operator given by stencils
+ *
+ * The row i of the n x n matrix is the stencil applied at the point i (columns i + S.first + j),
+ * using the one-sided stencils @p left for the first rows and @p right for the last ones
+ * (right[0] for the last row), that must only refer to the points 0 to n - 1.
+ * The rows are written directly into the band storage, in parallel.
+ *
+ * @code
+ * auto A = assemble_banded(n, D2, {D2_left}, {D2_right});
+ * @endcode
+ *
+ * @param n_threads Number of threads (0 for default_thread_count()).
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+BandedMatrix<Value> assemble_banded(std::size_t n, Stencil<Value, N> const& interior,
+                                    std::vector<Stencil<Value, N>> const& left = {}, std::vector<Stencil<Value, N>> const& right = {},
+                                    std::size_t n_threads = 0)
+{
+    auto const [kl, ku] = detail::bandwidths(interior, left, right, n);
+    BandedMatrix<Value> A(n, kl, ku);
+
+    parallel_for(n, [&] (std::size_t i) {
+        auto const& S = detail::row_stencil(interior, left, right, n, i);
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            std::ptrdiff_t const col = static_cast<std::ptrdiff_t>(i) + S.first + static_cast<std::ptrdiff_t>(j);
+            assert(col >= 0 and col < static_cast<std::ptrdiff_t>(n) && "Stencil outside of the domain");
+            A(i, static_cast<std::size_t>(col)) = S.weights[j];
+        }
+    }, n_threads, 1024);
+
+    return A;
+}
+
+/** @brief Assembles the CSR matrix of an operator given by stencils (see assemble_banded)
+ *
+ * Each row has exactly N elements (sorted by column, zero weights included), so that the row pointers
+ * are known beforehand and the rows are written directly into their place, in parallel.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+CsrMatrix<Value> assemble_csr(std::size_t n, Stencil<Value, N> const& interior,
+                              std::vector<Stencil<Value, N>> const& left = {}, std::vector<Stencil<Value, N>> const& right = {},
+                              std::size_t n_threads = 0)
+{
+    CsrMatrix<Value> A;
+    A.rows = A.cols = n;
+    A.row_ptr.resize(n + 1);
+    A.col_index.resize(n * N);
+    A.values.resize(n * N);
+
+    parallel_for(n + 1, [&] (std::size_t i) { A.row_ptr[i] = i * N; }, n_threads, 4096);
+    parallel_for(n, [&] (std::size_t i) {
+        auto const& S = detail::row_stencil(interior, left, right, n, i);
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            std::ptrdiff_t const col = static_cast<std::ptrdiff_t>(i) + S.first + static_cast<std::ptrdiff_t>(j);
+            assert(col >= 0 and col < static_cast<std::ptrdiff_t>(n) && "Stencil outside of the domain");
+            A.col_index[i * N + j] = static_cast<std::size_t>(col);
+            A.values[i * N + j] = S.weights[j];
+        }
+    }, n_threads, 1024);
+
+    return A;
+}
+
+/** @brief In-place LU factorization of a band matrix with partial pivoting (as LAPACK dgbtf2)
+ *
+ * On return, U is stored in the upper kl + ku diagonals and the multipliers of L below the diagonal,
+ * the row interchanges being stored in @p pivots.
+ *
+ * @return false as soon as a null pivot is found (singular matrix).
+ */
+template <typename Value>
+bool banded_lu(BandedMatrix<Value> & A, std::vector<std::size_t> & pivots) noexcept
+{
+    std::size_t const n = A.n;
+    pivots.resize(n);
+
+    std::size_t ju = 0; // Last column of U modified so far
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        std::size_t const km = (A.kl < n - 1 - j) ? A.kl : n - 1 - j;
+
+        // Partial pivoting
+        std::size_t p = j;
+        for (std::size_t i = j + 1; i <= j + km; ++i)
+            if (std::abs(A(i, j)) > std::abs(A(p, j)))
+                p = i;
+        pivots[j] = p;
+        if (A(p, j) == Value(0))
+            return false;
+
+        ju = std::max(ju, std::min(p + A.ku, n - 1));
+        if (p != j)
+            for (std::size_t c = j; c <= ju; ++c)
+                std::swap(A(j, c), A(p, c));
+
+        // Elimination
+        Value const inv_pivot = Value(1) / A(j, j);
+        for (std::size_t i = j + 1; i <= j + km; ++i)
+            A(i, j) *= inv_pivot;
+        for (std::size_t c = j + 1; c <= ju; ++c)
+        {
+            Value const u = A(j, c);
+            for (std::size_t i = j + 1; i <= j + km; ++i)
+                A(i, c) -= A(i, j) * u;
+        }
+    }
+
+    return true;
+}
+
+/// Solves A x = b in place using the factorization given by banded_lu (as LAPACK dgbtrs)
+template <typename Value>
+void banded_lu_solve(BandedMatrix<Value> const& A, std::vector<std::size_t> const& pivots, Value* b) noexcept
+{
+    std::size_t const n = A.n;
+
+    // L y = P b
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        std::swap(b[j], b[pivots[j]]);
+        std::size_t const km = (A.kl < n - 1 - j) ? A.kl : n - 1 - j;
+        for (std::size_t i = j + 1; i <= j + km; ++i)
+            b[i] -= A(i, j) * b[j];
+    }
+
+    // U x = y
+    std::size_t const ku = A.kl + A.ku;
+    for (std::size_t j = n; j-- > 0;)
+    {
+        b[j] /= A(j, j);
+        std::size_t const first = (j > ku) ? j - ku : 0;
+        for (std::size_t i = first; i < j; ++i)
+            b[i] -= A(i, j) * b[j];
+    }
+}
+
+} // namespace polysche
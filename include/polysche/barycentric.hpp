@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+
+#include "polynomial_scheme.hpp"
+#include "confluent_vandermonde.hpp"
+#include "utility.hpp"
+
+namespace polysche
+{
+
+/** @brief Lagrange interpolant at distinct nodes in barycentric form
+ *
+ * The barycentric weights w_i = 1 / prod_{j != i} (x_i - x_j) are computed once in O(N^2)
+ * operations. The stencil at a target x, that is the values l_i(x) of the Lagrange basis,
+ * is then computed in O(N) operations as l_i(x) = w_i prod_{j < i} (x - x_j) prod_{j > i} (x - x_j)
+ * using prefix and suffix products (no division, so that targets equal to a node are exact).
+ *
+ * Nodes are stored in the order of the equations of the scheme, so that the stencils
+ * apply to the same values than the polynomial returned by PolynomialScheme::solve.
+ *
+ * @code
+ * constexpr auto P = PolynomialScheme<3>{}.get_polynomial();
+ * constexpr auto PS = PolynomialScheme<3>{}.add_eqns(P(2), P(-1), P(0), P(1));
+ * constexpr auto B = make_barycentric(PS);
+ * auto weights = B.stencil(Rational<long long int>(1, 3)); // same as PS.solve()(1/3)
+ * @endcode
+ */
+template <
+    typename T,
+    std::size_t N
+>
+struct BarycentricInterpolant
+{
+    /// Number of targets processed together by the vectorized loops
+    static constexpr std::size_t chunk_size = 64;
+
+    std::array<T, N> nodes{}; ///< Interpolation nodes
+    std::array<T, N> weights{}; ///< Barycentric weights
+    bool is_valid = false; ///< false if the nodes are not distinct
+
+    constexpr BarycentricInterpolant() = default;
+
+    /// Interpolant at the given nodes
+    constexpr explicit BarycentricInterpolant(std::array<T, N> const& x) noexcept
+        : nodes(x)
+        , is_valid(true)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            T d = T(1);
+            for (std::size_t j = 0; j < N; ++j)
+                if (j != i)
+                    d = d * (nodes[i] - nodes[j]);
+
+            if (d == T(0))
+            {
+                is_valid = false;
+                return;
+            }
+            weights[i] = T(1) / d;
+        }
+    }
+
+    /// Stencil (values of the Lagrange basis) at the target @p x
+    constexpr std::array<T, N> stencil(T const& x) const noexcept
+    {
+        auto l = detail::filled_array<N>(T(0));
+        T prefix = T(1);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            l[i] = weights[i] * prefix;
+            prefix = prefix * (x - nodes[i]);
+        }
+
+        T suffix = T(1);
+        for (std::size_t i = N; i-- > 0;)
+        {
+            l[i] = l[i] * suffix;
+            suffix = suffix * (x - nodes[i]);
+        }
+        return l;
+    }
+
+    /// Value at the target @p x of the interpolant of the given values at the nodes
+    constexpr T operator() (T const& x, std::array<T, N> const& values) const noexcept
+    {
+        auto l = stencil(x);
+        T result = T(0);
+        for (std::size_t i = 0; i < N; ++i)
+            result = result + l[i] * values[i];
+        return result;
+    }
+
+    /** @brief Stencils at many targets
+     *
+     * The weight of the node i for the target k is stored in stencils[i * count + k]
+     * so that the loops over the targets are vectorized.
+     */
+    void stencils(T const* targets, std::size_t count, T* stencils) const noexcept
+    {
+        for (std::size_t first = 0; first < count; first += chunk_size)
+        {
+            std::size_t const size = (count - first < chunk_size) ? count - first : chunk_size;
+            stencils_chunk(targets + first, size, stencils + first, count);
+        }
+    }
+
+    /// Values at many targets of the interpolant of the given values at the nodes
+    void evaluate(std::array<T, N> const& values, T const* targets, std::size_t count, T* result) const noexcept
+    {
+        std::array<std::array<T, chunk_size>, N> l;
+        for (std::size_t first = 0; first < count; first += chunk_size)
+        {
+            std::size_t const size = (count - first < chunk_size) ? count - first : chunk_size;
+            stencils_chunk(targets + first, size, l[0].data(), chunk_size);
+
+            T* r = result + first;
+            for (std::size_t k = 0; k < size; ++k)
+                r[k] = T(0);
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t k = 0; k < size; ++k)
+                    r[k] = r[k] + l[i][k] * values[i];
+        }
+    }
+
+private:
+    /// Stencils at (at most chunk_size) targets, the weights of node i being stored from stencils + i * stride
+    void stencils_chunk(T const* x, std::size_t size, T* stencils, std::size_t stride) const noexcept
+    {
+        std::array<T, chunk_size> product;
+        for (std::size_t k = 0; k < size; ++k)
+            product[k] = T(1);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            T* l = stencils + i * stride;
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                l[k] = weights[i] * product[k];
+                product[k] = product[k] * (x[k] - nodes[i]);
+            }
+        }
+
+        for (std::size_t k = 0; k < size; ++k)
+            product[k] = T(1);
+
+        for (std::size_t i = N; i-- > 0;)
+        {
+            T* l = stencils + i * stride;
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                l[k] = l[k] * product[k];
+                product[k] = product[k] * (x[k] - nodes[i]);
+            }
+        }
+    }
+};
+
+/** @brief Barycentric interpolant of a scheme made of point evaluations only
+ *
+ * The returned interpolant is invalid if the scheme contains other equations
+ * (derivatives, integrals, ...) or if its nodes are not distinct.
+ */
+template <
+    std::size_t Order,
+    typename T
+>
+constexpr BarycentricInterpolant<T, Order + 1> make_barycentric(PolynomialScheme<Order, T> const& PS) noexcept
+{
+    BarycentricInterpolant<T, Order + 1> B{};
+
+    auto h = confluent_vandermonde_nodes(PS.matrix);
+    if (not h.is_valid)
+        return B;
+
+    // Point evaluations only: one row per node
+    auto x = detail::filled_array<Order + 1>(T(0));
+    for (std::size_t k = 0; k < Order + 1; ++k)
+    {
+        if (h.starts[k] != k)
+            return B;
+        x[h.rows[k]] = h.nodes[k];
+    }
+
+    return BarycentricInterpolant<T, Order + 1>(x);
+}
+
+} // namespace polysche
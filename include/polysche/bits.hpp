@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace polysche
+{
+
+namespace detail
+{
+
+/// Number of trailing zero bits of a non-null unsigned integer
+constexpr int count_trailing_zeros(unsigned long long v) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while ((v & 1ull) == 0)
+    {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/// Number of bits needed to represent an unsigned integer (0 for a null value)
+constexpr int bit_width(unsigned long long v) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (v == 0) ? 0 : 64 - __builtin_clzll(v);
+#else
+    int n = 0;
+    while (v != 0)
+    {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/// Word whose @p n lowest bits are set (n <= 64)
+constexpr std::uint64_t low_bits(std::size_t n) noexcept
+{
+    return (n < 64) ? (std::uint64_t(1) << n) - 1 : ~std::uint64_t(0);
+}
+
+} // namespace detail
+
+} // namespace polysche
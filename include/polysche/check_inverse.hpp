@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "rational.hpp"
+#include "utility.hpp"
+
+namespace polysche
+{
+
+namespace detail
+{
+
+/// Prime modulus used by the fingerprint check (2^31 - 1)
+inline constexpr std::uint64_t fingerprint_prime = 2147483647ull;
+
+/// SplitMix64 pseudo-random generator (constexpr replacement of std::random)
+constexpr std::uint64_t splitmix64(std::uint64_t & state) noexcept
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+constexpr std::uint64_t mod_pow(std::uint64_t a, std::uint64_t e) noexcept
+{
+    std::uint64_t r = 1;
+    a %= fingerprint_prime;
+    while (e > 0)
+    {
+        if (e & 1)
+            r = r * a % fingerprint_prime;
+        a = a * a % fingerprint_prime;
+        e >>= 1;
+    }
+    return r;
+}
+
+/// Residue of an integer modulo the fingerprint prime
+template <typename I>
+constexpr std::uint64_t mod_integer(I v) noexcept
+{
+    constexpr auto p = static_cast<long long int>(fingerprint_prime);
+    auto r = static_cast<long long int>(v) % p;
+    return static_cast<std::uint64_t>(r < 0 ? r + p : r);
+}
+
+/// Residue of a Rational modulo the fingerprint prime (false if the denominator is not invertible)
+template <typename I>
+constexpr bool mod_rational(Rational<I> const& v, std::uint64_t & residue) noexcept
+{
+    auto q = mod_integer(v.q);
+    if (q == 0)
+        return false;
+    residue = mod_integer(v.p) * mod_pow(q, fingerprint_prime - 2) % fingerprint_prime;
+    return true;
+}
+
+/// Pseudo-random vector of small positive integers
+template <
+    typename T,
+    std::size_t N
+>
+constexpr std::array<T, N> random_small_vector(std::uint64_t seed) noexcept
+{
+    auto x = filled_array<N>(T(0));
+    for (std::size_t i = 0; i < N; ++i)
+        x[i] = T(static_cast<int>(splitmix64(seed) % 1024 + 1));
+    return x;
+}
+
+/// Exact (or within tolerance for floating point values) check of A * (inv * x) == x
+template <
+    typename T,
+    std::size_t N
+>
+constexpr bool check_inverse_product(std::array<std::array<T, N>, N> const& A, std::array<std::array<T, N>, N> const& inv, std::array<T, N> const& x) noexcept
+{
+    auto y = filled_array<N>(T(0));
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < N; ++j)
+            y[i] = y[i] + inv[i][j] * x[j];
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        T z = T(0);
+        for (std::size_t j = 0; j < N; ++j)
+            z = z + A[i][j] * y[j];
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            using std::abs;
+            T scale = T(1);
+            for (std::size_t j = 0; j < N; ++j)
+                scale = scale + abs(A[i][j] * y[j]);
+            if (abs(z - x[i]) > T(64 * N) * std::numeric_limits<T>::epsilon() * scale)
+                return false;
+        }
+        else if (not (z == x[i]))
+            return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/** @brief Probabilistic check that @p inv is the inverse of @p A
+ *
+ * Instead of computing the whole product A * inv, it checks that A * (inv * x) == x
+ * for a pseudo-random vector x, using O(N^2) operations.
+ *
+ * For Rational values, the products are computed modulo a prime number so that
+ * they only involve machine integers without any overflow. A wrong inverse is then
+ * accepted with a probability of the order of 1 / (2^31 - 1).
+ * Other value types are checked exactly (or within a tolerance for floating point types).
+ *
+ * @param A     The matrix.
+ * @param inv   The candidate inverse.
+ * @param seed  Seed of the pseudo-random vector.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr bool check_inverse(std::array<std::array<T, N>, N> const& A, std::array<std::array<T, N>, N> const& inv, std::uint64_t seed = 0) noexcept
+{
+    using detail::fingerprint_prime;
+
+    if constexpr (is_rational_v<T>)
+    {
+        std::uint64_t state = seed;
+        std::array<std::uint64_t, N> x{};
+        for (std::size_t i = 0; i < N; ++i)
+            x[i] = detail::splitmix64(state) % fingerprint_prime;
+
+        // y = inv * x
+        std::array<std::uint64_t, N> y{};
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                std::uint64_t v = 0;
+                if (not detail::mod_rational(inv[i][j], v))
+                    return detail::check_inverse_product(A, inv, detail::random_small_vector<T, N>(seed));
+                y[i] = (y[i] + v * x[j]) % fingerprint_prime;
+            }
+
+        // A * y == x
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            std::uint64_t z = 0;
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                std::uint64_t v = 0;
+                if (not detail::mod_rational(A[i][j], v))
+                    return detail::check_inverse_product(A, inv, detail::random_small_vector<T, N>(seed));
+                z = (z + v * y[j]) % fingerprint_prime;
+            }
+            if (z != x[i])
+                return false;
+        }
+        return true;
+    }
+    else
+    {
+        return detail::check_inverse_product(A, inv, detail::random_small_vector<T, N>(seed));
+    }
+}
+
+} // namespace polysche
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+
+#include "utility.hpp"
+
+namespace polysche
+{
+
+/** @brief Nodes of a confluent Vandermonde system
+ *
+ * Each row of such a system corresponds to a constraint P^(d)(x) on a canonical polynomial P
+ * and, for each distinct node x, the derivation orders 0, 1, ..., m-1 must all appear (Hermite interpolation).
+ *
+ * The rows are ordered by node (in order of first appearance) then by derivation order.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+struct ConfluentNodes
+{
+    /// Node of each ordered row
+    std::array<T, N> nodes{};
+    /// Index in the original system of each ordered row
+    std::array<std::size_t, N> rows{};
+    /// Position in the ordered rows of the first row with the same node
+    std::array<std::size_t, N> starts{};
+    /// true if the system is actually a confluent Vandermonde system
+    bool is_valid = false;
+};
+
+/** @brief true if a linear system may have repeated nodes
+ *
+ * Repeated nodes imply derivative constraints, whose rows have a null first coefficient.
+ * This O(N) test lets the callers skip the O(N^2) detection of confluent_vandermonde_nodes
+ * for systems without any derivative (point values, cell averages, ...).
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr bool may_be_confluent(std::array<std::array<T, N>, N> const& A) noexcept
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (A[i][0] == T(0))
+            return true;
+    return false;
+}
+
+/** @brief Detects if a linear system comes from Hermite-type constraints
+ *
+ * It checks in O(N^2) operations that each row of @p A is of the form P^(d)(x),
+ * that is A[i][m] = m! / (m-d)! x^(m-d) for m >= d and 0 otherwise, and that
+ * the derivation orders at each node are contiguous from 0.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr ConfluentNodes<T, N> confluent_vandermonde_nodes(std::array<std::array<T, N>, N> const& A) noexcept
+{
+    ConfluentNodes<T, N> result{};
+    auto x = detail::filled_array<N>(T(0));
+    std::array<std::size_t, N> d{};
+
+    // Node and derivation order of each row
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto const& row = A[i];
+
+        std::size_t di = 0;
+        while (di < N and row[di] == T(0))
+            ++di;
+
+        // Null row
+        if (di == N)
+            return result;
+
+        T factorial = T(1);
+        for (std::size_t m = 2; m <= di; ++m)
+            factorial = factorial * T(m);
+        if (not (row[di] == factorial))
+            return result;
+
+        T xi = T(0);
+        if (di + 1 < N)
+        {
+            // A[i][di+1] = (di+1)! x
+            factorial = factorial * T(di + 1);
+            xi = row[di + 1] / factorial;
+
+            // A[i][m] = A[i][m-1] * x * m / (m - di)
+            T term = row[di + 1];
+            for (std::size_t m = di + 2; m < N; ++m)
+            {
+                term = term * xi * T(m) / T(m - di);
+                if (not (row[m] == term))
+                    return result;
+            }
+        }
+
+        x[i] = xi;
+        d[i] = di;
+    }
+
+    // The node of P^(N-1)(x) cannot be deduced from the row but such a constraint is valid
+    // only if all the other constraints are at the same node (Taylor expansion)
+    if (N > 1)
+        for (std::size_t i = 0; i < N; ++i)
+            if (d[i] == N - 1)
+                x[i] = x[(i + 1) % N];
+
+    // Ordering the rows by node then by derivation order
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        // Skipping already visited nodes
+        bool visited = false;
+        for (std::size_t k = 0; k < n and not visited; ++k)
+            visited = result.nodes[k] == x[i];
+        if (visited)
+            continue;
+
+        std::size_t start = n;
+        for (std::size_t order = 0; ; ++order)
+        {
+            std::size_t found = N;
+            for (std::size_t j = i; j < N; ++j)
+                if (d[j] == order and x[j] == x[i])
+                {
+                    // Duplicated constraint
+                    if (found != N)
+                        return result;
+                    found = j;
+                }
+
+            if (found == N)
+                break;
+
+            result.nodes[n] = x[i];
+            result.rows[n] = found;
+            result.starts[n] = start;
+            ++n;
+        }
+    }
+
+    // Missing derivation orders at some node
+    result.is_valid = (n == N);
+    return result;
+}
+
+/** @brief Inverse of a confluent Vandermonde matrix using generalized divided differences
+ *
+ * The divided differences are computed on the canonical basis of the constraints values
+ * (each value being a vector of size N) so that to directly get the interpolation polynomial
+ * in Newton form, that is then expanded in the monomial basis.
+ *
+ * No pivoting is involved and the solution of the system for a given right-hand side
+ * costs O(N^2) operations, so O(N^3) for the whole inverse.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr std::array<std::array<T, N>, N> confluent_vandermonde_inv(ConfluentNodes<T, N> const& h) noexcept
+{
+    auto const& z = h.nodes;
+
+    // Divided differences, c[i] being f[z_{i-k}, ..., z_i] after step k
+    // (explicitly filled, see detail::filled_array)
+    auto const zeros = detail::filled_array<N>(T(0));
+    auto c = detail::filled_array<N>(zeros);
+    for (std::size_t i = 0; i < N; ++i)
+        c[i][h.rows[h.starts[i]]] = T(1);
+
+    T factorial = T(1);
+    for (std::size_t k = 1; k < N; ++k)
+    {
+        factorial = factorial * T(k);
+        for (std::size_t i = N - 1; i >= k; --i)
+        {
+            if (i - k >= h.starts[i])
+            {
+                // Confluent nodes: f[z, ..., z] = f^(k)(z) / k!
+                c[i] = zeros;
+                c[i][h.rows[h.starts[i] + k]] = T(1) / factorial;
+            }
+            else
+            {
+                auto dz = z[i] - z[i - k];
+                for (std::size_t j = 0; j < N; ++j)
+                    c[i][j] = (c[i][j] - c[i - 1][j]) / dz;
+            }
+        }
+    }
+
+    // Newton form to monomial basis: P = c_0 + (X - z_0) (c_1 + (X - z_1) (c_2 + ...))
+    auto P = detail::filled_array<N>(zeros);
+    P[0] = c[N - 1];
+    for (std::size_t k = N - 1; k-- > 0; )
+    {
+        for (std::size_t m = N - 1 - k; m > 0; --m)
+            for (std::size_t j = 0; j < N; ++j)
+                P[m][j] = P[m - 1][j] - z[k] * P[m][j];
+
+        for (std::size_t j = 0; j < N; ++j)
+            P[0][j] = c[k][j] - z[k] * P[0][j];
+    }
+
+    return P;
+}
+
+} // namespace polysche
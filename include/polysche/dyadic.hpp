@@ -0,0 +1,390 @@
+#pragma once
+
+#include <iostream>
+#include <type_traits>
+#include <limits>
+
+#include "rational.hpp"
+#include "utility.hpp"
+#include "bits.hpp"
+
+namespace polysche
+{
+
+template <typename T>
+struct Dyadic;
+
+///////////////////////////////////////////////////////////////////////////////
+// Type traits
+
+template <typename T>
+struct IsDyadic : std::false_type {};
+
+template <typename T>
+struct IsDyadic<Dyadic<T>> : std::true_type {};
+
+/// Is true if type @c T decays to a Dyadic
+template <typename T>
+inline constexpr bool is_dyadic_v = IsDyadic<std::decay_t<T>>::value;
+
+/** @brief Constexpr implementation of dyadic rational numbers (m * 2^e with m a signed integer)
+ *
+ * Stencils with half-integer nodes or bounds often only involve power-of-two denominators
+ * (like 35/65536). For such values, the normalization is a shift of the trailing zero bits
+ * of the mantissa instead of a gcd computation, and the value is exactly representable
+ * as a floating point number.
+ *
+ * A value that is not dyadic (eg a division by 3) has no representation and leads to
+ * an invalid Dyadic (see is_valid), that propagates through the subsequent operations.
+ * The caller may then fall back to Rational (see PolynomialScheme::solve_dyadic).
+ *
+ * Conversion from a Rational is done using static_cast and is valid only if its denominator
+ * is a power of two.
+ *
+ * @tparam T    Value type of the mantissa (signed integers only).
+ */
+template <typename T>
+struct Dyadic
+{
+    using value_type = T;
+    static_assert(std::is_signed_v<value_type> and std::is_arithmetic_v<value_type>, "Dyadic type must be of signed integer type");
+
+    value_type m = 0; ///< Odd mantissa (or null)
+    int e = 0; ///< Exponent
+    bool valid = true;
+
+    /// Construction from an integer
+    constexpr Dyadic(T mm = 0)
+        : Dyadic(mm, 0)
+    {
+    }
+
+    /// Construction of mm * 2^ee (explicit so that {1, 2} is not mistaken for the Rational 1/2)
+    constexpr explicit Dyadic(T mm, int ee)
+    {
+        // Always constructing a normalized dyadic (odd mantissa)
+        if (mm == T(0))
+            return;
+
+        using U = std::make_unsigned_t<T>;
+        U um = (mm < T(0)) ? U(0) - static_cast<U>(mm) : static_cast<U>(mm);
+        int tz = detail::count_trailing_zeros(um);
+        m = mm / static_cast<T>(U(1) << tz);
+        e = ee + tz;
+    }
+
+    /// Invalid dyadic (result of an operation whose value is not dyadic)
+    static constexpr Dyadic invalid() noexcept
+    {
+        Dyadic d;
+        d.valid = false;
+        return d;
+    }
+
+    /// true if the value is actually a dyadic number
+    constexpr bool is_valid() const noexcept
+    {
+        return valid;
+    }
+
+    /// true if the mantissa is null
+    constexpr bool is_zero() const noexcept
+    {
+        return m == T(0);
+    }
+
+    /** @brief Conversion to an arithmetic type, a Rational or another Dyadic
+     *
+     * The conversion is exact for floating point types (in the range of the exponent).
+     * Conversely, a Rational is converted to a valid Dyadic only if its denominator is a power of two.
+     */
+    template <typename U>
+    constexpr operator U () const noexcept
+    {
+        if constexpr (is_dyadic_v<U>)
+        {
+            U result(static_cast<typename U::value_type>(m), e);
+            result.valid = valid;
+            return result;
+        }
+        else
+        {
+            // Scaling by chunks of 2^30 to stay in the range of T
+            U r = static_cast<U>(m);
+            for (int k = e; k > 0; k -= 30)
+                r = r * static_cast<U>(T(1) << (k < 30 ? k : 30));
+            for (int k = -e; k > 0; k -= 30)
+                r = r / static_cast<U>(T(1) << (k < 30 ? k : 30));
+            return r;
+        }
+    }
+};
+
+} // namespace polysche
+
+namespace std
+{
+/// Overload of std::common_type for a Dyadic and an arithmetic type
+template <typename T, typename U>
+struct common_type<polysche::Dyadic<T>, U> { using type = polysche::Dyadic<std::make_signed_t<std::common_type_t<T, U>>>; };
+
+/// Overload of std::common_type for an arithmetic type and a Dyadic
+template <typename T, typename U>
+struct common_type<U, polysche::Dyadic<T>> { using type = polysche::Dyadic<std::make_signed_t<std::common_type_t<T, U>>>; };
+
+/// Overload of std::common_type for two Dyadics
+template <typename T, typename U>
+struct common_type<polysche::Dyadic<T>, polysche::Dyadic<U>> { using type = polysche::Dyadic<std::common_type_t<T, U>>; };
+}
+
+namespace polysche {
+
+/** @brief Helper to reduce code duplication in binary operations
+ *
+ * It forwards given parameter "as it" if it is a Dyadic
+ * and otherwise returns the result of its conversion to a Dyadic.
+ */
+template <typename T>
+constexpr auto as_dyadic(T && v) noexcept -> decltype(auto)
+{
+    if constexpr (is_dyadic_v<T>)
+        return std::forward<T>(v);
+    else
+    {
+        static_assert(std::is_integral_v<std::decay_t<T>>, "Cannot convert to a Dyadic");
+        using type = std::make_signed_t<std::decay_t<T>>; // Ensure signed integer type
+        return Dyadic<type>{static_cast<type>(v)};
+    }
+}
+
+/// Enables binary operations between a Dyadic and a Dyadic or an integer
+/// (non-type parameter so that the signatures differ from the Rational ones)
+template <typename LHS, typename RHS>
+using enable_dyadic_t = std::enable_if_t<
+    (is_dyadic_v<LHS> or is_dyadic_v<RHS>) and not (is_rational_v<LHS> or is_rational_v<RHS>),
+    int
+>;
+
+/// Constexpr swap of Dyadics
+template <typename T>
+constexpr void swap(Dyadic<T> & lhs, Dyadic<T> & rhs) noexcept
+{
+    // std::swap isn't constexpr until C++20
+    Dyadic<T> tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+}
+
+/// Product
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator* (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    using value_type = decltype(lhs_d.m * rhs_d.m);
+    using result_type = Dyadic<value_type>;
+
+    value_type m = 0;
+    if (not lhs_d.valid or not rhs_d.valid or not detail::checked_mul<value_type>(lhs_d.m, rhs_d.m, m))
+        return result_type::invalid();
+
+    return result_type(m, lhs_d.e + rhs_d.e);
+}
+
+/// Division (invalid if the result is not a dyadic number)
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator/ (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    using result_type = decltype(Dyadic(lhs_d.m * rhs_d.m, 0));
+
+    // Mantissas being odd, the quotient is dyadic only if it is an integer
+    if (not lhs_d.valid or not rhs_d.valid or rhs_d.m == 0 or lhs_d.m % rhs_d.m != 0)
+        return result_type::invalid();
+
+    return result_type(lhs_d.m / rhs_d.m, lhs_d.e - rhs_d.e);
+}
+
+/// Addition (invalid if the aligned mantissas overflow)
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator+ (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    using value_type = decltype(lhs_d.m * rhs_d.m);
+    using result_type = Dyadic<value_type>;
+
+    if (not lhs_d.valid or not rhs_d.valid)
+        return result_type::invalid();
+
+    // Null exponent of zero is unrelated to the exponent of the other operand
+    if (lhs_d.m == 0)
+        return result_type(rhs_d.m, rhs_d.e);
+    if (rhs_d.m == 0)
+        return result_type(lhs_d.m, lhs_d.e);
+
+    // Aligning the exponents on the lowest one
+    bool const lhs_lowest = lhs_d.e <= rhs_d.e;
+    value_type const low = lhs_lowest ? lhs_d.m : rhs_d.m;
+    value_type const high = lhs_lowest ? rhs_d.m : lhs_d.m;
+    int const e = lhs_lowest ? lhs_d.e : rhs_d.e;
+    int const shift = lhs_lowest ? rhs_d.e - lhs_d.e : lhs_d.e - rhs_d.e;
+
+    value_type m = 0;
+    if (shift >= std::numeric_limits<value_type>::digits
+        or not detail::checked_mul(high, value_type(1) << shift, m)
+        or not detail::checked_add(low, m, m))
+        return result_type::invalid();
+
+    return result_type(m, e);
+}
+
+/// Subtraction
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator- (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    auto neg_rhs = Dyadic(-rhs_d.m, rhs_d.e);
+    neg_rhs.valid = rhs_d.valid;
+    return lhs_d + neg_rhs;
+}
+
+/// Equal to
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator== (LHS && lhs, RHS && rhs) noexcept
+{
+    // Normalized representation is unique
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    return lhs_d.valid and rhs_d.valid and lhs_d.m == rhs_d.m and lhs_d.e == rhs_d.e;
+}
+
+namespace detail
+{
+
+/** @brief Three-way comparison of two valid Dyadics (-1, 0 or 1)
+ *
+ * Compares the signs, then the positions of the highest bits, and only then the mantissas
+ * aligned on the same exponent, so that it never overflows (unlike the sign of the difference).
+ */
+template <
+    typename T,
+    typename U
+>
+constexpr int dyadic_compare(Dyadic<T> const& lhs, Dyadic<U> const& rhs) noexcept
+{
+    int const lhs_sign = (lhs.m > 0) - (lhs.m < 0);
+    int const rhs_sign = (rhs.m > 0) - (rhs.m < 0);
+    if (lhs_sign != rhs_sign)
+        return (lhs_sign < rhs_sign) ? -1 : 1;
+    if (lhs_sign == 0)
+        return 0;
+
+    // Odd mantissas so that their magnitude is representable
+    using value_type = std::make_unsigned_t<std::common_type_t<T, U>>;
+    value_type lhs_abs = (lhs.m < 0) ? value_type(0) - static_cast<value_type>(lhs.m) : static_cast<value_type>(lhs.m);
+    value_type rhs_abs = (rhs.m < 0) ? value_type(0) - static_cast<value_type>(rhs.m) : static_cast<value_type>(rhs.m);
+
+    // Highest bits at different positions
+    long long const lhs_top = static_cast<long long>(lhs.e) + bit_width(lhs_abs);
+    long long const rhs_top = static_cast<long long>(rhs.e) + bit_width(rhs_abs);
+    int magnitude = (lhs_top < rhs_top) ? -1 : (lhs_top > rhs_top) ? 1 : 0;
+
+    // Same position: aligning on the lowest exponent cannot overflow
+    if (magnitude == 0)
+    {
+        if (lhs.e > rhs.e)
+            lhs_abs <<= lhs.e - rhs.e;
+        else
+            rhs_abs <<= rhs.e - lhs.e;
+        magnitude = (lhs_abs < rhs_abs) ? -1 : (lhs_abs > rhs_abs) ? 1 : 0;
+    }
+
+    return lhs_sign * magnitude;
+}
+
+} // namespace detail
+
+/// Lower than (false if an operand is invalid)
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator< (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    return lhs_d.valid and rhs_d.valid and detail::dyadic_compare(lhs_d, rhs_d) < 0;
+}
+
+/// Greater than (false if an operand is invalid)
+template <
+    typename LHS,
+    typename RHS,
+    enable_dyadic_t<LHS, RHS> = 0
+>
+constexpr auto operator> (LHS && lhs, RHS && rhs) noexcept
+{
+    auto && lhs_d = as_dyadic(std::forward<LHS>(lhs));
+    auto && rhs_d = as_dyadic(std::forward<RHS>(rhs));
+    return lhs_d.valid and rhs_d.valid and detail::dyadic_compare(lhs_d, rhs_d) > 0;
+}
+
+/// Sign bit of a Dyadic (true if negative, false otherwise)
+template <typename T>
+constexpr bool signbit(Dyadic<T> const& d) noexcept
+{
+    return d.m < T(0);
+}
+
+/// Absolute value of a Dyadic
+template <typename T>
+constexpr auto abs(Dyadic<T> const& d) noexcept
+{
+    auto result = Dyadic<T>((d.m >= 0) ? d.m : -d.m, d.e);
+    result.valid = d.valid;
+    return result;
+}
+
+/// Representation of a Dyadic (as a fraction if it fits the mantissa type)
+template <typename T>
+std::ostream& operator<< (std::ostream& out, Dyadic<T> const& d)
+{
+    constexpr int digits = std::numeric_limits<T>::digits;
+
+    if (not d.is_valid())
+        return out << "invalid";
+
+    if (d.e >= 0 and d.e < digits and d.m == (d.m * (T(1) << d.e)) / (T(1) << d.e))
+        out << d.m * (T(1) << d.e);
+    else if (d.e < 0 and -d.e < digits)
+        out << d.m << "/" << (T(1) << -d.e);
+    else
+        out << d.m << "*2^" << d.e;
+    return out;
+}
+
+} // namespace polysche
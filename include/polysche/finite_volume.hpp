@@ -0,0 +1,237 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "rational.hpp"
+#include "polynomial_scheme.hpp"
+#include "stencil.hpp"
+
+namespace polysche
+{
+
+/** @brief Reconstruction of the value at a face from cell averages
+ *
+ * The cell c being [c, c + 1], the face f is at x = f, between the cells f - 1 and f.
+ * The returned stencil, applied at the face f (see Stencil), gives the value at the face
+ * of the polynomial of degree Order whose averages on the cells f + first, ..., f + first + Order
+ * are the given ones. It is computed exactly, then converted to @p Value.
+ *
+ * @code
+ * constexpr auto left = make_face_reconstruction<2>(-2);  // left state from the cells f - 2, f - 1, f
+ * constexpr auto right = make_face_reconstruction<2>(-1); // right state from the cells f - 1, f, f + 1
+ * @endcode
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_face_reconstruction(int first) noexcept
+{
+    constexpr auto PS = PolynomialScheme<Order>{};
+    constexpr auto P = PS.get_polynomial();
+    auto const S = PS.add_eqns(Order + 1, [&P, first] (std::size_t j) {
+        int const c = first + static_cast<int>(j);
+        return P.integrate(c, c + 1);
+    }).solve();
+    return make_stencil<Value>(S(0), first);
+}
+
+/** @brief Left and right states at the faces for a reconstruction of degree Order
+ *
+ * For an even Order, the left (resp. right) state is the reconstruction centered on the cell
+ * at the left (resp. right) of the face. For an odd Order, both states are given by the
+ * reconstruction centered on the face.
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_face_states() noexcept
+{
+    constexpr int k = static_cast<int>(Order) / 2;
+    if constexpr (Order % 2 == 0)
+        return std::array{make_face_reconstruction<Order, Value>(-1 - k), make_face_reconstruction<Order, Value>(-k)};
+    else
+        return std::array{make_face_reconstruction<Order, Value>(-k - 1), make_face_reconstruction<Order, Value>(-k - 1)};
+}
+
+/** @brief Divergence of the fluxes of a finite volume scheme in flux form
+ *
+ * out[c] = F_{c+1} - F_c for each cell c in [0, count[ where F_f = flux(left(u + f), right(u + f))
+ * is the numerical flux at the face f computed from its left and right reconstructed states.
+ * The cells are processed by tiles: the states at the faces of a tile are reconstructed
+ * (vectorized), each flux is computed once into a face array, then differentiated.
+ * The flux of the last face of a tile is reused for the next tile, so that each face
+ * is computed exactly once and the scheme is conservative (the sum of out telescopes).
+ *
+ * @p u must be readable around the cells (eg using ghost cells) for the reconstructions
+ * at the faces 0 to count.
+ *
+ * @param flux  Numerical flux, called as flux(left_state, right_state).
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t M,
+    typename Flux
+>
+void flux_divergence(Stencil<Value, N> const& left, Stencil<Value, M> const& right, Flux && flux,
+                     Value const* u, std::size_t count, Value* out)
+{
+    constexpr std::size_t tile = 256;
+    std::array<Value, tile + 1> u_left, u_right, F;
+
+    for (std::size_t start = 0; start < count; start += tile)
+    {
+        std::size_t const size = (count - start < tile) ? count - start : tile;
+        std::size_t const first_face = (start == 0) ? 0 : 1; // Flux of the first face known from the previous tile
+        std::size_t const faces = size + 1 - first_face;
+
+        apply_stencil(left, u + start + first_face, faces, u_left.data() + first_face);
+        apply_stencil(right, u + start + first_face, faces, u_right.data() + first_face);
+        for (std::size_t f = first_face; f <= size; ++f)
+            F[f] = flux(u_left[f], u_right[f]);
+
+        for (std::size_t c = 0; c < size; ++c)
+            out[start + c] = F[c + 1] - F[c];
+
+        F[0] = F[size];
+    }
+}
+
+/** @brief Upwind-biased states at the faces for a reconstruction of degree Order
+ *
+ * The first stencil is biased to the left of the face (upwind for a positive velocity)
+ * and the second one to the right (upwind for a negative velocity).
+ * For an even Order, they are the reconstructions centered on the cells at the left and the right of the face,
+ * and for an odd Order, they use one more cell on the upwind side.
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_upwind_states() noexcept
+{
+    constexpr int left_first = -1 - static_cast<int>(Order + 1) / 2;
+    constexpr int right_first = -static_cast<int>(Order) / 2;
+    return std::array{make_face_reconstruction<Order, Value>(left_first), make_face_reconstruction<Order, Value>(right_first)};
+}
+
+/** @brief Upwind states at the faces, selected by the sign of the velocity
+ *
+ * out[f] = left(u + f) if velocity[f] >= 0, right(u + f) otherwise, for f in [0, count[.
+ * Both states are computed for all the faces and blended using a select on the sign of the velocity
+ * instead of a branch per face, so that the loop is vectorized and mixed-sign velocity fields
+ * don't lead to branch mispredictions.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t M
+>
+void upwind_states(Stencil<Value, N> const& left, Stencil<Value, M> const& right, Value const* velocity,
+                   Value const* u, std::size_t count, Value* out) noexcept
+{
+    constexpr std::size_t tile = 256;
+    std::array<Value, tile> u_left, u_right;
+
+    for (std::size_t start = 0; start < count; start += tile)
+    {
+        std::size_t const size = (count - start < tile) ? count - start : tile;
+        apply_stencil(left, u + start, size, u_left.data());
+        apply_stencil(right, u + start, size, u_right.data());
+
+        Value const* a = velocity + start;
+        Value* s = out + start;
+        for (std::size_t f = 0; f < size; ++f)
+            s[f] = (a[f] >= Value(0)) ? u_left[f] : u_right[f];
+    }
+}
+
+/** @brief Divergence of the upwind advective fluxes (flux form)
+ *
+ * out[c] = F_{c+1} - F_c for each cell c in [0, count[ where F_f = velocity[f] s_f is the advective flux
+ * at the face f with the upwind state s_f (see upwind_states), @p velocity being given at the faces 0 to count.
+ * Each face flux is computed once, so that the scheme is conservative.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t M
+>
+void upwind_divergence(Stencil<Value, N> const& left, Stencil<Value, M> const& right, Value const* velocity,
+                       Value const* u, std::size_t count, Value* out) noexcept
+{
+    constexpr std::size_t tile = 256;
+    std::array<Value, tile + 1> F;
+
+    for (std::size_t start = 0; start < count; start += tile)
+    {
+        std::size_t const size = (count - start < tile) ? count - start : tile;
+        std::size_t const first_face = (start == 0) ? 0 : 1; // Flux of the first face known from the previous tile
+
+        upwind_states(left, right, velocity + start + first_face, u + start + first_face, size + 1 - first_face, F.data() + first_face);
+        for (std::size_t f = first_face; f <= size; ++f)
+            F[f] *= velocity[start + f];
+
+        for (std::size_t c = 0; c < size; ++c)
+            out[start + c] = F[c + 1] - F[c];
+
+        F[0] = F[size];
+    }
+}
+
+/** @brief Conversion of cell averages to point values at the cell centers
+ *
+ * Value at the center of the cell of the polynomial of degree Order (even) whose averages
+ * on the Order + 1 cells centered on it are the given ones, computed exactly.
+ * In several dimensions, the conversion is the tensor product of the 1D one (see apply_stencil_tensor).
+ *
+ * @code
+ * constexpr auto A2P = make_average_to_point<4>(); // fourth-order deconvolution
+ * apply_stencil_tensor(A2P, averages, points);     // 1D, 2D or 3D views
+ * @endcode
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_average_to_point() noexcept
+{
+    static_assert(Order % 2 == 0, "The conversion must be centered");
+    constexpr int k = static_cast<int>(Order) / 2;
+
+    constexpr auto PS = PolynomialScheme<Order>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(Order + 1, [&P] (std::size_t i) {
+        int const j = static_cast<int>(i) - k;
+        return P.integrate({2 * j - 1, 2}, {2 * j + 1, 2});
+    }).solve();
+    return make_stencil<Value>(S(0), -k);
+}
+
+/** @brief Conversion of point values at the cell centers to cell averages
+ *
+ * Average on the cell of the polynomial of degree Order (even) whose values at the centers
+ * of the Order + 1 cells centered on it are the given ones, computed exactly.
+ * It is the inverse of make_average_to_point up to the order of the reconstruction.
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_point_to_average() noexcept
+{
+    static_assert(Order % 2 == 0, "The conversion must be centered");
+    constexpr int k = static_cast<int>(Order) / 2;
+
+    constexpr auto PS = PolynomialScheme<Order>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(Order + 1, [&P] (std::size_t i) {
+        return P(static_cast<int>(i) - k);
+    }).solve();
+    return make_stencil<Value>(S.integrate({-1, 2}, {1, 2}), -k);
+}
+
+} // namespace polysche
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+
+#include "utility.hpp"
 
 namespace polysche
 {
@@ -17,19 +20,45 @@ constexpr void swap_array(std::array<T, N> & lhs, std::array<T, N> & rhs) noexce
     rhs = tmp;
 }
 
-/// Gauss-Jordan elimination of a matrix M x N 
+/** @brief Result of a linear solve with its regularity status
+ *
+ * When the elimination stops early on a singular matrix, @c rank is the number of pivots
+ * found so far (a lower bound of the actual rank) and @c value is meaningless.
+ */
+template <typename Value>
+struct SolveResult
+{
+    Value value{};
+    std::size_t rank = 0;
+    bool is_regular = false;
+
+    constexpr explicit operator bool () const noexcept
+    {
+        return is_regular;
+    }
+};
+
+/** @brief In-place Gauss-Jordan elimination of a matrix M x N
+ *
+ * The pivots are searched only in the first @p P columns and, if @p stop_on_singular is true,
+ * the elimination stops as soon as one of these columns has no pivot or as soon as
+ * a value becomes invalid (eg a Dyadic that is not dyadic, see detail::is_valid_value),
+ * the remaining of the elimination being then meaningless.
+ *
+ * @return the number of found pivots.
+ */
 template <
     typename T,
     std::size_t M,
     std::size_t N
 >
-constexpr std::array<std::array<T, N>, M> gauss(std::array<std::array<T, N>, M> A) noexcept
+constexpr std::size_t gauss_reduce(std::array<std::array<T, N>, M> & A, std::size_t P = N, bool stop_on_singular = false) noexcept
 {
     using std::abs;
     using std::swap;
 
     std::size_t r = 0;
-    for (std::size_t j = 0; j < N and r < M; ++j)
+    for (std::size_t j = 0; j < P and r < M; ++j)
     {
         std::size_t k = r;
         auto kv = A[k][j];
@@ -40,10 +69,21 @@ constexpr std::array<std::array<T, N>, M> gauss(std::array<std::array<T, N>, M>
                 kv = A[i][j];
             }
         
-        if (kv == T(0)) continue;
+        if (kv == T(0))
+        {
+            if (stop_on_singular)
+                return r;
+            continue;
+        }
 
+        bool valid = true;
         for (std::size_t jj = 0; jj < N; ++jj)
+        {
             A[k][jj] = A[k][jj] / kv;
+            valid = valid and detail::is_valid_value(A[k][jj]);
+        }
+        if (stop_on_singular and not valid)
+            return r;
 
         if (k != r)
             swap_array(A[k], A[r]);
@@ -53,25 +93,69 @@ constexpr std::array<std::array<T, N>, M> gauss(std::array<std::array<T, N>, M>
             if (i != r)
             {
                 auto c = A[i][j];
+                if (c == T(0))
+                    continue;
                 for (std::size_t jj = 0; jj < N; ++jj)
+                {
                     A[i][jj] = A[i][jj] - A[r][jj] * c;
+                    valid = valid and detail::is_valid_value(A[i][jj]);
+                }
             }
         }
+        if (stop_on_singular and not valid)
+            return r;
 
         ++r;
     }
 
+    return r;
+}
+
+/// Gauss-Jordan elimination of a matrix M x N 
+template <
+    typename T,
+    std::size_t M,
+    std::size_t N
+>
+constexpr std::array<std::array<T, N>, M> gauss(std::array<std::array<T, N>, M> A) noexcept
+{
+    gauss_reduce(A);
     return A;
 }
 
-/// Solve a linear system using Gauss-Jordan algorithm
+/// Rank of a matrix M x N
 template <
     typename T,
+    std::size_t M,
     std::size_t N
 >
-constexpr std::array<T, N> gauss_solve(std::array<std::array<T, N>, N> const& A, std::array<T, N> const& b) noexcept
+constexpr std::size_t gauss_rank(std::array<std::array<T, N>, M> A) noexcept
+{
+    return gauss_reduce(A);
+}
+
+/** @brief true if a square matrix is regular
+ *
+ * The elimination is done on the matrix only (not augmented) and stops
+ * at the first column without pivot, so that singular matrices are rejected early.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr bool gauss_is_regular(std::array<std::array<T, N>, N> A) noexcept
+{
+    return gauss_reduce(A, N, true) == N;
+}
+
+/// Solve a linear system using Gauss-Jordan algorithm, stopping early if the matrix is singular
+template <
+    typename T,
+    std::size_t N
+>
+constexpr SolveResult<std::array<T, N>> gauss_solve_checked(std::array<std::array<T, N>, N> const& A, std::array<T, N> const& b) noexcept
 {
-    std::array<std::array<T, N + 1>, N> augmented_A;
+    auto augmented_A = detail::filled_array<N>(detail::filled_array<N + 1>(T(0)));
     for (std::size_t i = 0; i < N; ++i)
     {
         for (std::size_t j = 0; j < N; ++j)
@@ -79,21 +163,35 @@ constexpr std::array<T, N> gauss_solve(std::array<std::array<T, N>, N> const& A,
         augmented_A[i][N] = b[i];
     }
 
-    auto reducted_A = gauss(augmented_A);
-    std::array<T, N> solution;
-    for (std::size_t i = 0; i < N; ++i)
-        solution[i] = reducted_A[i][N] / reducted_A[i][i];
-    return solution;
+    SolveResult<std::array<T, N>> result{};
+    result.rank = gauss_reduce(augmented_A, N, true);
+    result.is_regular = result.rank == N;
+    if (result.is_regular)
+        for (std::size_t i = 0; i < N; ++i)
+            result.value[i] = augmented_A[i][N];
+    return result;
+}
+
+/// Solve a linear system using Gauss-Jordan algorithm
+template <
+    typename T,
+    std::size_t N
+>
+constexpr std::array<T, N> gauss_solve(std::array<std::array<T, N>, N> const& A, std::array<T, N> const& b) noexcept
+{
+    auto result = gauss_solve_checked(A, b);
+    assert(result.is_regular && "Singular matrix");
+    return result.value;
 }   
 
-/// Compute the inverse of a matrix using Gauss-Jordan algorithm
+/// Compute the inverse of a matrix using Gauss-Jordan algorithm, stopping early if the matrix is singular
 template <
     typename T,
     std::size_t N
 >
-constexpr std::array<std::array<T, N>, N> gauss_inv(std::array<std::array<T, N>, N> const& A) noexcept
+constexpr SolveResult<std::array<std::array<T, N>, N>> gauss_inv_checked(std::array<std::array<T, N>, N> const& A) noexcept
 {
-    std::array<std::array<T, N + N>, N> augmented_A;
+    auto augmented_A = detail::filled_array<N>(detail::filled_array<N + N>(T(0)));
     for (std::size_t i = 0; i < N; ++i)
     {
         for (std::size_t j = 0; j < N; ++j)
@@ -103,13 +201,83 @@ constexpr std::array<std::array<T, N>, N> gauss_inv(std::array<std::array<T, N>,
         }
     }
 
-    auto reducted_A = gauss(augmented_A);
+    SolveResult<std::array<std::array<T, N>, N>> result{};
+    result.rank = gauss_reduce(augmented_A, N, true);
+    result.is_regular = result.rank == N;
+    if (result.is_regular)
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+                result.value[i][j] = augmented_A[i][j + N];
+    return result;
+}
 
-    std::array<std::array<T, N>, N> inv;
+/// Compute the inverse of a matrix using Gauss-Jordan algorithm
+template <
+    typename T,
+    std::size_t N
+>
+constexpr std::array<std::array<T, N>, N> gauss_inv(std::array<std::array<T, N>, N> const& A) noexcept
+{
+    auto result = gauss_inv_checked(A);
+    assert(result.is_regular && "Singular matrix");
+    return result.value;
+}
+
+/** @brief Denominator of the Sherman-Morrison update when replacing a row of a matrix
+ *
+ * Given the inverse @p inv of a matrix A, returns the value that is null if and only if
+ * the matrix obtained by replacing the row @p k of A by @p row is singular.
+ * It costs O(N) operations.
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr T inv_replace_row_pivot(std::array<std::array<T, N>, N> const& inv, std::size_t k, std::array<T, N> const& row) noexcept
+{
+    // With c = inv * e_k, the denominator 1 + (row - A_k) * c reduces to row * c since A_k * c = 1
+    T d = T(0);
+    for (std::size_t i = 0; i < N; ++i)
+        d = d + row[i] * inv[i][k];
+    return d;
+}
+
+/** @brief Inverse of a matrix after replacing one of its rows (Sherman-Morrison formula)
+ *
+ * Given the inverse @p inv of a matrix A, returns the inverse of the matrix obtained
+ * by replacing the row @p k of A by @p row, using O(N^2) operations.
+ * The updated matrix must be regular (see inv_replace_row_pivot).
+ */
+template <
+    typename T,
+    std::size_t N
+>
+constexpr std::array<std::array<T, N>, N> inv_replace_row(std::array<std::array<T, N>, N> const& inv, std::size_t k, std::array<T, N> const& row) noexcept
+{
+    auto d = inv_replace_row_pivot(inv, k, row);
+    assert(not (d == T(0)) && "Singular matrix after row replacement");
+
+    // z = (row - A_k) * inv = row * inv - e_k
+    auto z = detail::filled_array<N>(T(0));
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < N; ++j)
+            z[j] = z[j] + row[i] * inv[i][j];
+    z[k] = z[k] - T(1);
+
+    for (std::size_t j = 0; j < N; ++j)
+        z[j] = z[j] / d;
+
+    std::array<std::array<T, N>, N> result = inv;
     for (std::size_t i = 0; i < N; ++i)
+    {
+        auto c = inv[i][k];
+        if (c == T(0))
+            continue;
+
         for (std::size_t j = 0; j < N; ++j)
-            inv[i][j] = reducted_A[i][j + N];
-    return inv;
+            result[i][j] = result[i][j] - c * z[j];
+    }
+    return result;
 }
 
 } // namespace polysche
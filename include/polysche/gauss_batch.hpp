@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace polysche
+{
+
+/** @brief Batch of B square matrices N x N in SoA layout
+ *
+ * The coefficient (i, j) of the matrix of lane l is stored in A[i][j][l] so that
+ * the lanes of a coefficient are contiguous and can be processed in SIMD registers.
+ */
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+using BatchMatrix = std::array<std::array<std::array<T, B>, N>, N>;
+
+/// Batch of B vectors of size N in SoA layout (coefficient i of lane l in x[i][l])
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+using BatchVector = std::array<std::array<T, B>, N>;
+
+/** @brief Result of a batch of linear solves with the regularity status of each lane
+ *
+ * The values of the singular lanes are meaningless (but don't affect the other lanes).
+ */
+template <
+    typename Value,
+    std::size_t B
+>
+struct BatchSolveResult
+{
+    Value value{};
+    std::array<bool, B> is_regular{}; ///< true for the lanes whose matrix is regular
+};
+
+namespace detail
+{
+
+/** @brief Lane-wise Gauss-Jordan elimination of a batch of systems A X = R with M right-hand sides
+ *
+ * The partial pivoting is done lane-wise using selects (a row is swapped with the pivot row
+ * in the lanes where it has a greater coefficient) so that no branch depends on the values
+ * and all the lanes follow the same control flow.
+ *
+ * A lane is considered singular if one of its pivots is not greater than
+ * N epsilon max |A_ij| (rounding errors being of that order for a singular matrix).
+ * The pivots of the singular lanes are replaced by 1 so that their values remain finite.
+ *
+ * @return the regularity status of each lane.
+ */
+template <
+    typename T,
+    std::size_t N,
+    std::size_t M,
+    std::size_t B
+>
+std::array<bool, B> gauss_jordan_batch(BatchMatrix<T, N, B> & A, std::array<std::array<std::array<T, B>, M>, N> & R) noexcept
+{
+    using std::abs;
+
+    // Singularity threshold of each lane
+    std::array<T, B> threshold{};
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < N; ++j)
+            for (std::size_t l = 0; l < B; ++l)
+                threshold[l] = (abs(A[i][j][l]) > threshold[l]) ? abs(A[i][j][l]) : threshold[l];
+    for (std::size_t l = 0; l < B; ++l)
+        threshold[l] *= T(N) * std::numeric_limits<T>::epsilon();
+
+    std::array<bool, B> is_regular;
+    is_regular.fill(true);
+
+    for (std::size_t j = 0; j < N; ++j)
+    {
+        // Lane-wise pivoting: moving the greatest coefficient of column j to row j
+        for (std::size_t i = j + 1; i < N; ++i)
+        {
+            std::array<bool, B> swap;
+            for (std::size_t l = 0; l < B; ++l)
+                swap[l] = abs(A[i][j][l]) > abs(A[j][j][l]);
+
+            for (std::size_t jj = j; jj < N; ++jj)
+                for (std::size_t l = 0; l < B; ++l)
+                {
+                    T a = A[j][jj][l], c = A[i][jj][l];
+                    A[j][jj][l] = swap[l] ? c : a;
+                    A[i][jj][l] = swap[l] ? a : c;
+                }
+
+            for (std::size_t k = 0; k < M; ++k)
+                for (std::size_t l = 0; l < B; ++l)
+                {
+                    T a = R[j][k][l], c = R[i][k][l];
+                    R[j][k][l] = swap[l] ? c : a;
+                    R[i][k][l] = swap[l] ? a : c;
+                }
+        }
+
+        // Normalization of the pivot row
+        std::array<T, B> inv_pivot;
+        for (std::size_t l = 0; l < B; ++l)
+        {
+            bool const singular = not (abs(A[j][j][l]) > threshold[l]);
+            is_regular[l] = is_regular[l] and not singular;
+            inv_pivot[l] = T(1) / (singular ? T(1) : A[j][j][l]);
+        }
+
+        for (std::size_t jj = j + 1; jj < N; ++jj)
+            for (std::size_t l = 0; l < B; ++l)
+                A[j][jj][l] *= inv_pivot[l];
+
+        for (std::size_t k = 0; k < M; ++k)
+            for (std::size_t l = 0; l < B; ++l)
+                R[j][k][l] *= inv_pivot[l];
+
+        // Elimination in the other rows
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i == j)
+                continue;
+
+            std::array<T, B> factor = A[i][j];
+            for (std::size_t jj = j + 1; jj < N; ++jj)
+                for (std::size_t l = 0; l < B; ++l)
+                    A[i][jj][l] -= factor[l] * A[j][jj][l];
+
+            for (std::size_t k = 0; k < M; ++k)
+                for (std::size_t l = 0; l < B; ++l)
+                    R[i][k][l] -= factor[l] * R[j][k][l];
+        }
+    }
+
+    return is_regular;
+}
+
+} // namespace detail
+
+/** @brief Solves a batch of B linear systems using lane-wise Gauss-Jordan elimination
+ *
+ * Meant for many small floating point systems (eg one per cell of a non-uniform grid),
+ * B being a multiple of the SIMD width (4, 8 or 16). The singular lanes are reported
+ * in the result (see detail::gauss_jordan_batch) without affecting the other lanes.
+ */
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+BatchSolveResult<BatchVector<T, N, B>, B> gauss_solve_batch_checked(BatchMatrix<T, N, B> A, BatchVector<T, N, B> const& b) noexcept
+{
+    std::array<std::array<std::array<T, B>, 1>, N> R;
+    for (std::size_t i = 0; i < N; ++i)
+        R[i][0] = b[i];
+
+    BatchSolveResult<BatchVector<T, N, B>, B> result;
+    result.is_regular = detail::gauss_jordan_batch(A, R);
+    for (std::size_t i = 0; i < N; ++i)
+        result.value[i] = R[i][0];
+    return result;
+}
+
+/// Solves a batch of B linear systems using lane-wise Gauss-Jordan elimination (see gauss_solve_batch_checked)
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+BatchVector<T, N, B> gauss_solve_batch(BatchMatrix<T, N, B> const& A, BatchVector<T, N, B> const& b) noexcept
+{
+    return gauss_solve_batch_checked(A, b).value;
+}
+
+/// Computes the inverses of a batch of B matrices, reporting the singular lanes
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+BatchSolveResult<BatchMatrix<T, N, B>, B> gauss_inv_batch_checked(BatchMatrix<T, N, B> A) noexcept
+{
+    BatchSolveResult<BatchMatrix<T, N, B>, B> result;
+    for (std::size_t i = 0; i < N; ++i)
+        result.value[i][i].fill(T(1));
+
+    result.is_regular = detail::gauss_jordan_batch(A, result.value);
+    return result;
+}
+
+/// Computes the inverses of a batch of B matrices using lane-wise Gauss-Jordan elimination
+template <
+    typename T,
+    std::size_t N,
+    std::size_t B
+>
+BatchMatrix<T, N, B> gauss_inv_batch(BatchMatrix<T, N, B> const& A) noexcept
+{
+    return gauss_inv_batch_checked(A).value;
+}
+
+} // namespace polysche
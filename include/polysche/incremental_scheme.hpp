@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <cassert>
+
+#include "rational.hpp"
+#include "polynomial.hpp"
+#include "polynomial_scheme.hpp"
+#include "utility.hpp"
+#include "scheme_builder.hpp"
+
+namespace polysche
+{
+
+/** @brief Polynomial scheme whose linear system is reduced as the equations are added
+ *
+ * Each new equation is eliminated against the already reduced ones (online Gauss-Jordan elimination)
+ * so that the final solve only reorders the reduced rows.
+ *
+ * Since the scheme is a value type, a partially reduced scheme can be copied and completed
+ * in different ways, the elimination of the common equations being done only once:
+ * @code
+ * constexpr auto common = IncrementalScheme<2>{}.add_eqns(P(0), P(1));
+ * constexpr auto S_dirichlet = common.add_eqn(P(-1)).solve();
+ * constexpr auto S_neumann = common.add_eqn(P.derivate()(0)).solve();
+ * @endcode
+ */
+template <
+    std::size_t Order,
+    typename T = Rational<long long int>
+>
+struct IncrementalScheme : SchemeBuilder<IncrementalScheme<Order, T>, Order, T>
+{
+    static constexpr std::size_t N = Order + 1;
+    static constexpr std::size_t no_pivot = N;
+
+    using equation_type = std::array<T, N>;
+
+    /// Reduced rows of the augmented matrix [A | E] where E is the product of the applied elementary operations
+    std::array<std::array<T, N + N>, N> reduced;
+    /// Pivot column of each reduced row (no_pivot if the equation is linearly dependent of the previous ones)
+    std::array<std::size_t, N> pivots{};
+    std::size_t index = 0;
+    std::size_t rank = 0;
+
+    constexpr IncrementalScheme() {};
+
+    /// Reduces the equations of the given scheme
+    constexpr IncrementalScheme(PolynomialScheme<Order, T> const& PS) noexcept
+    {
+        for (std::size_t i = 0; i < PS.index; ++i)
+            push_eqn(PS.matrix[i]);
+    }
+
+    /// true if the equations added so far are linearly independent
+    constexpr bool is_regular() const noexcept
+    {
+        return rank == index;
+    }
+
+    /// Appends and reduces an equation in place
+    constexpr IncrementalScheme & push_eqn(equation_type const& coeffs) noexcept
+    {
+        using std::abs;
+
+        auto row = detail::filled_array<N + N>(T(0));
+        for (std::size_t j = 0; j < N; ++j)
+            row[j] = coeffs[j];
+        row[N + index] = T(1);
+
+        // Elimination against the already reduced rows
+        // (right part is null after column N + index)
+        for (std::size_t r = 0; r < index; ++r)
+        {
+            if (pivots[r] == no_pivot)
+                continue;
+
+            auto c = row[pivots[r]];
+            if (c == T(0))
+                continue;
+
+            for (std::size_t j = 0; j < N + index; ++j)
+                row[j] = row[j] - reduced[r][j] * c;
+        }
+
+        // Pivot search in the remaining columns
+        std::size_t p = no_pivot;
+        T pv = T(0);
+        for (std::size_t j = 0; j < N; ++j)
+            if (abs(row[j]) > abs(pv))
+            {
+                p = j;
+                pv = row[j];
+            }
+
+        if (p != no_pivot)
+        {
+            for (std::size_t j = 0; j < N + index + 1; ++j)
+                row[j] = row[j] / pv;
+
+            // Jordan step: clearing the new pivot column in the previous rows
+            for (std::size_t r = 0; r < index; ++r)
+            {
+                auto c = reduced[r][p];
+                if (c == T(0))
+                    continue;
+
+                for (std::size_t j = 0; j < N + index + 1; ++j)
+                    reduced[r][j] = reduced[r][j] - row[j] * c;
+            }
+
+            ++rank;
+        }
+
+        reduced[index] = row;
+        pivots[index] = p;
+        ++index;
+        return *this;
+    }
+
+    /// Interpolation polynomial (the reduced rows are only permuted)
+    constexpr auto solve() const noexcept
+    {
+        assert(index == N && rank == N && "Incomplete or singular scheme");
+
+        Polynomial<T, Order, N> P{};
+        for (std::size_t i = 0; i < index; ++i)
+        {
+            if (pivots[i] == no_pivot)
+                continue;
+
+            for (std::size_t j = 0; j < N; ++j)
+                P.coeffs[pivots[i]][j] = reduced[i][N + j];
+        }
+        return P;
+    }
+};
+
+} // namespace polysche
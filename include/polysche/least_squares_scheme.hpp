@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "rational.hpp"
+#include "polynomial.hpp"
+#include "gauss.hpp"
+#include "utility.hpp"
+#include "scheme_builder.hpp"
+
+namespace polysche
+{
+
+/** @brief Scheme with more equations than unknowns, solved in the least-squares sense
+ *
+ * As for PolynomialScheme, each equation is a linear form on the coefficients of a polynomial
+ * of degree Order (eg a value or an average) but there are M >= Order + 1 of them.
+ * The solution is the polynomial minimizing the sum of the squared residuals of the equations,
+ * that is the pseudo-inverse (A^T A)^{-1} A^T of the matrix of the system.
+ *
+ * @code
+ * constexpr auto LS = LeastSquaresScheme<2, 5>{};
+ * constexpr auto P = LS.get_polynomial();
+ * constexpr auto S = LS.add_eqns(P(-2), P(-1), P(0), P(1), P(2)).solve();
+ * constexpr auto smoothing = S(0); // Savitzky-Golay smoothing stencil
+ * @endcode
+ */
+template <
+    std::size_t Order,
+    std::size_t M,
+    typename T = Rational<long long int>
+>
+struct LeastSquaresScheme : SchemeBuilder<LeastSquaresScheme<Order, M, T>, Order, T>
+{
+    static_assert(M >= Order + 1, "Least-squares scheme needs at least Order + 1 equations");
+
+    using equation_type = std::array<T, Order + 1>;
+
+    std::array<std::array<T, Order + 1>, M> matrix;
+    std::size_t index = 0;
+
+    constexpr LeastSquaresScheme() {};
+
+    /// Appends an equation in place (no copy of the scheme)
+    constexpr LeastSquaresScheme & push_eqn(equation_type const& coeffs) noexcept
+    {
+        matrix[index] = coeffs;
+        ++index;
+        return *this;
+    }
+
+    /// Matrix A^T A of the normal equations
+    constexpr auto normal_matrix() const noexcept
+    {
+        auto G = detail::filled_array<Order + 1>(detail::filled_array<Order + 1>(T(0)));
+        for (std::size_t i = 0; i < Order + 1; ++i)
+            for (std::size_t j = 0; j < Order + 1; ++j)
+            {
+                T g = T(0);
+                for (std::size_t k = 0; k < M; ++k)
+                    g = g + matrix[k][i] * matrix[k][j];
+                G[i][j] = g;
+            }
+        return G;
+    }
+
+    /// true if the equations determine a unique least-squares polynomial (A of full column rank)
+    constexpr bool is_regular() const noexcept
+    {
+        return gauss_is_regular(normal_matrix());
+    }
+
+    /** @brief Least-squares polynomial
+     *
+     * The coefficients of degree d of the result are the weights of the M equations values.
+     */
+    constexpr auto solve() const noexcept
+    {
+        return pseudo_inverse(gauss_inv(normal_matrix()));
+    }
+
+    /// Least-squares polynomial with the regularity status of the normal equations
+    constexpr auto solve_checked() const noexcept
+    {
+        auto inv = gauss_inv_checked(normal_matrix());
+        SolveResult<Polynomial<T, Order, M>> result{};
+        result.rank = inv.rank;
+        result.is_regular = inv.is_regular;
+        if (inv.is_regular)
+            result.value = pseudo_inverse(inv.value);
+        return result;
+    }
+
+private:
+    /// (A^T A)^{-1} A^T from the inverse of the normal matrix
+    constexpr auto pseudo_inverse(std::array<std::array<T, Order + 1>, Order + 1> const& inv) const noexcept
+    {
+        Polynomial<T, Order, M> P{};
+        for (std::size_t degree = 0; degree < Order + 1; ++degree)
+            for (std::size_t k = 0; k < M; ++k)
+            {
+                T c = T(0);
+                for (std::size_t j = 0; j < Order + 1; ++j)
+                    c = c + inv[degree][j] * matrix[k][j];
+                P.coeffs[degree][k] = c;
+            }
+        return P;
+    }
+};
+
+} // namespace polysche
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define POLYSCHE_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace polysche
+{
+
+/** @brief Raw binary file mapped in memory
+ *
+ * On POSIX systems, the file is memory-mapped so that only the pages being accessed are loaded,
+ * with advices to the kernel about the access pattern (sequential reading, prefetching of the next
+ * tile, release of the processed tiles). Otherwise, the file is read into memory and
+ * written back when closed.
+ */
+class MappedFile
+{
+public:
+    /// Access mode
+    enum class Mode
+    {
+        read,   ///< Opens an existing file read-only
+        write,  ///< Creates (or truncates) the file to the given size, read-write
+    };
+
+    MappedFile() = default;
+
+    /** @brief Maps a file
+     *
+     * In write mode, the file is created or truncated even if the given size is 0,
+     * but an empty mapping is not valid.
+     *
+     * @param path      Path to the file.
+     * @param mode      Access mode.
+     * @param size      Size in bytes of the file to create (write mode only).
+     */
+    explicit MappedFile(std::string const& path, Mode mode = Mode::read, std::size_t size = 0)
+        : writable(mode == Mode::write)
+        , path(path)
+    {
+#ifdef POLYSCHE_HAS_MMAP
+        int fd = writable ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+
+        struct stat st;
+        if (writable and ::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            return;
+        }
+        if (not writable)
+            size = (::fstat(fd, &st) == 0) ? static_cast<std::size_t>(st.st_size) : 0;
+
+        if (size > 0)
+        {
+            void* addr = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                bytes = static_cast<unsigned char*>(addr);
+                length = size;
+            }
+        }
+        ::close(fd);
+#else
+        if (writable)
+        {
+            if (size == 0)
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                return;
+            }
+            buffer.resize(size);
+        }
+        else
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (not file)
+                return;
+            buffer.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            if (not file)
+                return;
+        }
+        bytes = buffer.data();
+        length = buffer.size();
+#endif
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator= (MappedFile const&) = delete;
+
+    MappedFile(MappedFile && other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& operator= (MappedFile && other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            bytes = other.bytes;
+            length = other.length;
+            writable = other.writable;
+            path = std::move(other.path);
+            buffer = std::move(other.buffer);
+            other.bytes = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    /// true if the file is mapped
+    bool is_valid() const noexcept
+    {
+        return bytes != nullptr;
+    }
+
+    /// Size in bytes
+    std::size_t size() const noexcept
+    {
+        return length;
+    }
+
+    unsigned char* data() const noexcept
+    {
+        return bytes;
+    }
+
+    /// Advises that the file will be accessed sequentially (aggressive read-ahead)
+    void advise_sequential() const noexcept
+    {
+#ifdef POLYSCHE_HAS_MMAP
+        if (bytes != nullptr)
+            ::madvise(bytes, length, MADV_SEQUENTIAL);
+#endif
+    }
+
+    /// Asynchronously loads the given range (so that the reading overlaps the current computation)
+    void prefetch(std::size_t offset, std::size_t count) const noexcept
+    {
+        advise(offset, count, true);
+    }
+
+    /// Releases the given range from memory (written back to the file if modified)
+    void release(std::size_t offset, std::size_t count) const noexcept
+    {
+#ifdef POLYSCHE_HAS_MMAP
+        if (writable and bytes != nullptr)
+        {
+            auto range = page_range(offset, count);
+            ::msync(bytes + range.first, range.second, MS_ASYNC);
+        }
+#endif
+        advise(offset, count, false);
+    }
+
+    /// Unmaps the file (and writes it back if it is not memory-mapped)
+    bool close() noexcept
+    {
+        bool ok = true;
+#ifdef POLYSCHE_HAS_MMAP
+        if (bytes != nullptr)
+            ::munmap(bytes, length);
+#else
+        if (writable and bytes != nullptr)
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            ok = static_cast<bool>(file);
+        }
+        buffer.clear();
+#endif
+        bytes = nullptr;
+        length = 0;
+        return ok;
+    }
+
+private:
+    /// Range aligned on the pages (offset, size)
+    std::pair<std::size_t, std::size_t> page_range(std::size_t offset, std::size_t count) const noexcept
+    {
+#ifdef POLYSCHE_HAS_MMAP
+        auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#else
+        std::size_t const page = 4096;
+#endif
+        std::size_t const end = (offset + count < length) ? offset + count : length;
+        offset = (offset < end) ? offset / page * page : end;
+        return {offset, end - offset};
+    }
+
+    void advise(std::size_t offset, std::size_t count, bool will_need) const noexcept
+    {
+#ifdef POLYSCHE_HAS_MMAP
+        if (bytes == nullptr)
+            return;
+        auto range = page_range(offset, count);
+        if (range.second > 0)
+            ::madvise(bytes + range.first, range.second, will_need ? MADV_WILLNEED : MADV_DONTNEED);
+#else
+        (void)offset;
+        (void)count;
+        (void)will_need;
+#endif
+    }
+
+    unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    bool writable = false;
+    std::string path;
+    std::vector<unsigned char> buffer;
+};
+
+} // namespace polysche
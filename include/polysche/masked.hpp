@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bits.hpp"
+#include "stencil.hpp"
+
+namespace polysche
+{
+
+/// Interval [first, last[ of active cells
+struct Interval
+{
+    std::size_t first = 0;
+    std::size_t last = 0;
+
+    constexpr std::size_t size() const noexcept
+    {
+        return last - first;
+    }
+};
+
+/** @brief Calls f(first, last) for each maximal run [first, last[ of active cells of a bitset
+ *
+ * The cell i is active if the bit i % 64 of mask[i / 64] is set (bits beyond @p count are ignored).
+ * Empty and full words are skipped or merged as a whole, and the runs are found
+ * using trailing zeros count, so that the cost depends on the number of runs.
+ */
+template <typename Function>
+void for_each_run(std::uint64_t const* mask, std::size_t count, Function && f)
+{
+    std::size_t run_first = 0;
+    std::size_t run_last = 0; // Pending run (merged across words)
+
+    auto add = [&] (std::size_t first, std::size_t last) {
+        if (first == run_last and run_last > run_first)
+        {
+            run_last = last;
+            return;
+        }
+        if (run_last > run_first)
+            f(run_first, run_last);
+        run_first = first;
+        run_last = last;
+    };
+
+    std::size_t const words = (count + 63) / 64;
+    for (std::size_t k = 0; k < words; ++k)
+    {
+        std::size_t const base = 64 * k;
+        std::uint64_t w = mask[k] & detail::low_bits(count - base);
+
+        if (w == ~std::uint64_t(0))
+        {
+            add(base, base + 64);
+            continue;
+        }
+
+        while (w != 0)
+        {
+            int const start = detail::count_trailing_zeros(w);
+            std::uint64_t const shifted = ~(w >> start);
+            int const length = (shifted == 0) ? 64 - start : detail::count_trailing_zeros(shifted);
+            add(base + static_cast<std::size_t>(start), base + static_cast<std::size_t>(start + length));
+            w &= (start + length < 64) ? ~((std::uint64_t(1) << (start + length)) - 1) : 0;
+        }
+    }
+
+    if (run_last > run_first)
+        f(run_first, run_last);
+}
+
+/// Intervals of active cells of a bitset (see for_each_run)
+inline std::vector<Interval> make_intervals(std::uint64_t const* mask, std::size_t count)
+{
+    std::vector<Interval> intervals;
+    for_each_run(mask, count, [&intervals] (std::size_t first, std::size_t last) {
+        intervals.push_back({first, last});
+    });
+    return intervals;
+}
+
+/** @brief Applies a stencil on the given intervals of active cells only
+ *
+ * out[i] = S(in + i) for i in each interval, the other values of @p out being left unchanged.
+ * The application is vectorized inside each interval.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+void apply_stencil_intervals(Stencil<Value, N> const& S, Value const* in, std::vector<Interval> const& intervals, Value* out) noexcept
+{
+    for (auto const& interval : intervals)
+        apply_stencil(S, in + interval.first, interval.size(), out + interval.first);
+}
+
+namespace detail
+{
+
+/** @brief Calls f(base, size, w) for each non-empty word of a bitset
+ *
+ * @p w is the word of the cells [base, base + size[ (size being 64 except for the last word)
+ * with the bits beyond @p count cleared.
+ */
+template <typename Function>
+void for_each_word(std::uint64_t const* mask, std::size_t count, Function && f)
+{
+    for (std::size_t base = 0; base < count; base += 64)
+    {
+        std::size_t const size = (count - base < 64) ? count - base : 64;
+        std::uint64_t const w = mask[base / 64] & low_bits(size);
+        if (w != 0)
+            f(base, size, w);
+    }
+}
+
+} // namespace detail
+
+/** @brief Applies a stencil on the active cells of a bitset only
+ *
+ * out[i] = S(in + i) for each active cell i in [0, count[ (see for_each_run),
+ * the other values of @p out being left unchanged.
+ *
+ * Each non-empty word is computed densely (vectorized), the results of the partially active
+ * words being then written using a masked store. @p in must thus be readable for the stencils
+ * of all the cells of [0, count[, active or not.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+void apply_stencil_masked(Stencil<Value, N> const& S, Value const* in, std::uint64_t const* mask, std::size_t count, Value* out)
+{
+    std::array<Value, 64> dense;
+    detail::for_each_word(mask, count, [&] (std::size_t base, std::size_t size, std::uint64_t w) {
+        if (w == detail::low_bits(size))
+        {
+            apply_stencil(S, in + base, size, out + base);
+            return;
+        }
+
+        apply_stencil(S, in + base, size, dense.data());
+        Value* o = out + base;
+        for (std::size_t i = 0; i < size; ++i)
+            o[i] = ((w >> i) & 1) ? dense[i] : o[i];
+    });
+}
+
+/** @brief Applies a stencil on the active cells of a bitset and stores the results contiguously
+ *
+ * The stencil at the k-th active cell is stored in out[k] (compress-store),
+ * eg for a storage of the active cells only.
+ *
+ * As for apply_stencil_masked, the partially active words are computed densely
+ * so that @p in must be readable for the stencils of all the cells of [0, count[.
+ *
+ * @return the number of active cells.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+std::size_t apply_stencil_compressed(Stencil<Value, N> const& S, Value const* in, std::uint64_t const* mask, std::size_t count, Value* out)
+{
+    std::array<Value, 64> dense;
+    std::size_t written = 0;
+    detail::for_each_word(mask, count, [&] (std::size_t base, std::size_t size, std::uint64_t w) {
+        if (w == detail::low_bits(size))
+        {
+            apply_stencil(S, in + base, size, out + written);
+            written += size;
+            return;
+        }
+
+        apply_stencil(S, in + base, size, dense.data());
+        for (; w != 0; w &= w - 1)
+            out[written++] = dense[static_cast<std::size_t>(detail::count_trailing_zeros(w))];
+    });
+    return written;
+}
+
+} // namespace polysche
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "rational.hpp"
+#include "polynomial_scheme.hpp"
+#include "utility.hpp"
+
+namespace polysche
+{
+
+/* Linear multistep methods
+ *
+ * The coefficients are computed from the interpolation polynomial in time of the stored values,
+ * in the time variable normalized by the current step: t_n = 0 and t_{n+1} = 1.
+ * The nodes of the past values are thus t_{n-j} = -(h_{n-1} + ... + h_{n-j}) / h_n,
+ * that is -j for a fixed step (see variable_step_nodes).
+ *
+ * The coefficients are exact for rational nodes, and can be computed at compile time.
+ */
+
+namespace detail
+{
+
+/// Interpolation polynomial in time at the given nodes
+template <
+    typename T,
+    std::size_t K
+>
+constexpr auto time_interpolation(std::array<T, K> const& nodes) noexcept
+{
+    static_assert(K > 0, "At least one node is needed");
+    auto const PS = PolynomialScheme<K - 1, T>{};
+    auto const P = PS.get_polynomial();
+    return PS.add_eqns(K, [&P, &nodes] (std::size_t j) {
+        return P(nodes[j]);
+    }).solve();
+}
+
+/// Nodes 1 (if implicit), 0, -1, ..., of a fixed-step method
+template <
+    std::size_t K,
+    typename T
+>
+constexpr std::array<T, K> fixed_step_nodes(bool implicit) noexcept
+{
+    auto nodes = filled_array<K>(T(0));
+    for (std::size_t j = 0; j < K; ++j)
+        nodes[j] = T(implicit ? 1 - static_cast<int>(j) : -static_cast<int>(j));
+    return nodes;
+}
+
+} // namespace detail
+
+/** @brief Normalized nodes 0, t_{n-1}, ..., t_{n-K} of the past values from the past step sizes
+ *
+ * @param steps     Past step sizes h_{n-1}, ..., h_{n-K}.
+ * @param h         Current step size h_n.
+ */
+template <
+    typename T,
+    std::size_t K
+>
+constexpr std::array<T, K + 1> variable_step_nodes(std::array<T, K> const& steps, T const& h) noexcept
+{
+    auto nodes = detail::filled_array<K + 1>(T(0));
+    for (std::size_t j = 0; j < K; ++j)
+        nodes[j + 1] = nodes[j] - steps[j] / h;
+    return nodes;
+}
+
+/** @brief Coefficients of an Adams method at the given nodes
+ *
+ * y_{n+1} = y_n + h_n sum_j b_j f(t_j) where b_j is the integral from 0 to 1 of the Lagrange polynomial of the node j.
+ * Explicit (Adams-Bashforth) for the nodes 0, t_{n-1}, ... and implicit (Adams-Moulton) when 1 is one of the nodes.
+ */
+template <
+    typename T,
+    std::size_t Steps
+>
+constexpr std::array<T, Steps> adams_coefficients(std::array<T, Steps> const& nodes) noexcept
+{
+    return detail::time_interpolation(nodes).integrate(T(0), T(1));
+}
+
+/** @brief Coefficients of the fixed-step Adams-Bashforth method of order Steps
+ *
+ * y_{n+1} = y_n + h sum_{j < Steps} b_j f_{n-j}
+ *
+ * @code
+ * constexpr auto b = adams_bashforth<3>(); // 23/12, -4/3, 5/12
+ * @endcode
+ */
+template <
+    std::size_t Steps,
+    typename T = Rational<long long int>
+>
+constexpr std::array<T, Steps> adams_bashforth() noexcept
+{
+    return adams_coefficients(detail::fixed_step_nodes<Steps, T>(false));
+}
+
+/** @brief Coefficients of the fixed-step Adams-Moulton method of order Steps + 1
+ *
+ * y_{n+1} = y_n + h sum_{j <= Steps} b_j f_{n+1-j}
+ */
+template <
+    std::size_t Steps,
+    typename T = Rational<long long int>
+>
+constexpr std::array<T, Steps + 1> adams_moulton() noexcept
+{
+    return adams_coefficients(detail::fixed_step_nodes<Steps + 1, T>(true));
+}
+
+/** @brief Coefficients of a backward differentiation formula at the given nodes
+ *
+ * sum_j a_j y(t_j) = h_n f(t_{n+1}) where a_j is the derivative at 1 of the Lagrange polynomial of the node j,
+ * the first node being 1 (that is t_{n+1}).
+ */
+template <
+    typename T,
+    std::size_t K
+>
+constexpr std::array<T, K> bdf_coefficients(std::array<T, K> const& nodes) noexcept
+{
+    return detail::time_interpolation(nodes).derivate()(T(1));
+}
+
+/** @brief Coefficients of the fixed-step backward differentiation formula of order Steps
+ *
+ * sum_{j <= Steps} a_j y_{n+1-j} = h f_{n+1}
+ *
+ * @code
+ * constexpr auto a = bdf<2>(); // 3/2, -2, 1/2
+ * @endcode
+ */
+template <
+    std::size_t Steps,
+    typename T = Rational<long long int>
+>
+constexpr std::array<T, Steps + 1> bdf() noexcept
+{
+    return bdf_coefficients(detail::fixed_step_nodes<Steps + 1, T>(true));
+}
+
+/** @brief Fused update of a linear multistep method
+ *
+ * out[i] = sum_k a_k y_k[i] + h sum_m b_m f_m[i] for i in [0, count[,
+ * computed in a single pass over the stored values and right-hand sides.
+ * The coefficients are converted to @p Value once.
+ *
+ * @code
+ * constexpr auto b = adams_bashforth<3>();
+ * multistep_update(std::array{1}, std::array{y_n}, b, std::array{f_n, f_n1, f_n2}, h, n, y_next); // pointers to const
+ * @endcode
+ *
+ * For a BDF, y_{n+1} = sum_k (-a_{k+1} / a_0) y_{n-k} + h (1 / a_0) f_{n+1} is of this form
+ * (f_{n+1} being given by the nonlinear solver).
+ */
+template <
+    typename T,
+    std::size_t K,
+    typename U,
+    std::size_t M,
+    typename Value
+>
+void multistep_update(std::array<T, K> const& a, std::array<Value const*, K> const& y,
+                      std::array<U, M> const& b, std::array<Value const*, M> const& f,
+                      Value h, std::size_t count, Value* out) noexcept
+{
+    std::array<Value, K> ca{};
+    for (std::size_t k = 0; k < K; ++k)
+        ca[k] = static_cast<Value>(a[k]);
+    std::array<Value, M> cb{};
+    for (std::size_t m = 0; m < M; ++m)
+        cb[m] = h * static_cast<Value>(b[m]);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Value r = Value(0);
+        for (std::size_t k = 0; k < K; ++k)
+            r += ca[k] * y[k][i];
+        for (std::size_t m = 0; m < M; ++m)
+            r += cb[m] * f[m][i];
+        out[i] = r;
+    }
+}
+
+} // namespace polysche
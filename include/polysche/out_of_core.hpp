@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stencil.hpp"
+#include "mapped_file.hpp"
+
+namespace polysche
+{
+
+namespace detail
+{
+
+/** @brief Processes the output rows of a file-to-file operation by tiles
+ *
+ * Before processing a tile, the input rows of the next tile are prefetched so that the reading
+ * overlaps the computation, and once processed, the input rows no more needed and the output
+ * rows are released, so that the memory footprint is bounded by a few tiles.
+ *
+ * @param input_rows    Function returning the range [first, last[ of the input rows needed by given output rows.
+ * @param process       Function processing the given output rows.
+ */
+template <
+    typename InputRows,
+    typename Process
+>
+void process_tiles(MappedFile const& input, std::size_t input_row_bytes, MappedFile const& output, std::size_t output_row_bytes,
+                   std::size_t rows, std::size_t tile_rows, InputRows && input_rows, Process && process)
+{
+    input.advise_sequential();
+    tile_rows = (tile_rows > 0) ? tile_rows : 1;
+
+    std::size_t released = 0; // Input rows already released
+    for (std::size_t start = 0; start < rows; start += tile_rows)
+    {
+        std::size_t const end = (start + tile_rows < rows) ? start + tile_rows : rows;
+
+        // Prefetching the next tile (double buffering by the page cache)
+        if (end < rows)
+        {
+            auto next = input_rows(end, (end + tile_rows < rows) ? end + tile_rows : rows);
+            input.prefetch(next.first * input_row_bytes, (next.second - next.first) * input_row_bytes);
+        }
+
+        process(start, end);
+
+        // Releasing the processed rows (except the halo of the next tile)
+        output.release(start * output_row_bytes, (end - start) * output_row_bytes);
+        std::size_t const needed = (end < rows) ? input_rows(end, end + 1).first : input_rows(start, end).second;
+        if (needed > released)
+        {
+            input.release(released * input_row_bytes, (needed - released) * input_row_bytes);
+            released = needed;
+        }
+    }
+}
+
+} // namespace detail
+
+/** @brief Applies a stencil on a raw binary file of values, by tiles
+ *
+ * The output file contains the stencil at each point of the input whose stencil is inside
+ * the data (valid convolution), that is n - N + 1 values, the k-th being the stencil
+ * at the input point k - S.first.
+ *
+ * The files are memory-mapped and processed by tiles of @p tile values (with a halo of N - 1 values)
+ * so that datasets larger than the memory can be processed.
+ *
+ * @return false if a file cannot be read or written, if the input is not made of whole values
+ *         or if it is smaller than the stencil.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+bool apply_stencil_file(Stencil<Value, N> const& S, std::string const& input, std::string const& output, std::size_t tile = std::size_t(1) << 20)
+{
+    MappedFile in(input);
+    if (not in.is_valid() or in.size() % sizeof(Value) != 0 or in.size() < N * sizeof(Value))
+        return false;
+
+    std::size_t const n = in.size() / sizeof(Value);
+    std::size_t const count = n - N + 1;
+    MappedFile out(output, MappedFile::Mode::write, count * sizeof(Value));
+    if (not out.is_valid())
+        return false;
+
+    auto const u = reinterpret_cast<Value const*>(in.data());
+    auto const v = reinterpret_cast<Value*>(out.data());
+
+    detail::process_tiles(in, sizeof(Value), out, sizeof(Value), count, tile,
+        [] (std::size_t begin, std::size_t end) { return std::pair<std::size_t, std::size_t>{begin, end + N - 1}; },
+        [&] (std::size_t begin, std::size_t end) { apply_stencil(S, u + begin - S.first, end - begin, v + begin); }
+    );
+
+    return out.close();
+}
+
+/** @brief Applies a stencil along an axis of a 2D array stored in a raw binary file, by tiles
+ *
+ * The input is a row-major array of rows of @p nx values. The output contains the stencil
+ * at each point whose stencil is inside the data (valid convolution), that is
+ * rows of nx - N + 1 values along the axis 0 (x) and ny - N + 1 rows of nx values along the axis 1 (y).
+ *
+ * The files are memory-mapped and processed by tiles of @p tile_rows output rows
+ * (with a halo of N - 1 rows along y), so that datasets larger than the memory can be processed.
+ * Along y, the stencil is applied to whole rows so that the loads are contiguous.
+ *
+ * @return false if a file cannot be read or written, if the input is not made of whole rows
+ *         or is smaller than the stencil along the axis, or if the axis is neither 0 nor 1.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+bool apply_stencil_file_2d(Stencil<Value, N> const& S, std::string const& input, std::string const& output,
+                           std::size_t nx, std::size_t axis, std::size_t tile_rows = 256)
+{
+    if (nx == 0 or axis > 1)
+        return false;
+
+    MappedFile in(input);
+    if (not in.is_valid() or in.size() % (nx * sizeof(Value)) != 0)
+        return false;
+
+    std::size_t const ny = in.size() / sizeof(Value) / nx;
+    if (ny == 0 or (axis == 0 and nx < N) or (axis == 1 and ny < N))
+        return false;
+
+    std::size_t const out_nx = (axis == 0) ? nx - N + 1 : nx;
+    std::size_t const out_ny = (axis == 0) ? ny : ny - N + 1;
+    MappedFile out(output, MappedFile::Mode::write, out_nx * out_ny * sizeof(Value));
+    if (not out.is_valid())
+        return false;
+
+    auto const u = reinterpret_cast<Value const*>(in.data());
+    auto const v = reinterpret_cast<Value*>(out.data());
+    std::size_t const halo = (axis == 0) ? 0 : N - 1;
+
+    detail::process_tiles(in, nx * sizeof(Value), out, out_nx * sizeof(Value), out_ny, tile_rows,
+        [halo] (std::size_t begin, std::size_t end) { return std::pair<std::size_t, std::size_t>{begin, end + halo}; },
+        [&] (std::size_t begin, std::size_t end)
+        {
+            for (std::size_t row = begin; row < end; ++row)
+            {
+                Value* w = v + row * out_nx;
+                if (axis == 0)
+                {
+                    apply_stencil(S, u + row * nx - S.first, out_nx, w);
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < nx; ++i)
+                        w[i] = Value(0);
+                    for (std::size_t j = 0; j < N; ++j)
+                    {
+                        Value const weight = S.weights[j];
+                        Value const* r = u + (row + j) * nx;
+                        for (std::size_t i = 0; i < nx; ++i)
+                            w[i] += weight * r[i];
+                    }
+                }
+            }
+        }
+    );
+
+    return out.close();
+}
+
+} // namespace polysche
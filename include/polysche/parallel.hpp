@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace polysche
+{
+
+/// Number of threads used when none is specified (number of hardware threads, at least 1)
+inline std::size_t default_thread_count() noexcept
+{
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/** @brief Calls f(i) for each i in [0, count[ using a pool of threads
+ *
+ * The indices are distributed dynamically by chunks of @p grain indices so that
+ * tasks of uneven cost are balanced between the threads.
+ * The calling thread takes part in the computation and the function returns
+ * once all the indices have been processed.
+ *
+ * @param count     Number of indices.
+ * @param f         Function called for each index (concurrently from different threads).
+ * @param n_threads Number of threads (0 for default_thread_count()).
+ * @param grain     Number of consecutive indices processed by a thread at once.
+ */
+template <typename F>
+void parallel_for(std::size_t count, F && f, std::size_t n_threads = 0, std::size_t grain = 1)
+{
+    if (n_threads == 0)
+        n_threads = default_thread_count();
+    grain = std::max<std::size_t>(1, grain);
+    n_threads = std::min(n_threads, (count + grain - 1) / grain);
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] ()
+    {
+        for (std::size_t start = next.fetch_add(grain); start < count; start = next.fetch_add(grain))
+        {
+            std::size_t end = std::min(start + grain, count);
+            for (std::size_t i = start; i < end; ++i)
+                f(i);
+        }
+    };
+
+    if (n_threads <= 1)
+    {
+        worker();
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for (std::size_t t = 0; t + 1 < n_threads; ++t)
+        threads.emplace_back(worker);
+    worker();
+
+    for (auto & thread : threads)
+        thread.join();
+}
+
+} // namespace polysche
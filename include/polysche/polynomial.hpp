@@ -4,6 +4,8 @@
 #include <type_traits>
 #include <iostream>
 
+#include "utility.hpp"
+
 namespace polysche
 {
 
@@ -78,7 +80,7 @@ struct Polynomial
         auto Pa = P(a);
         auto Pb = P(b);
 
-        std::array<T, N> result{};
+        auto result = detail::filled_array<N>(T(0));
         for (std::size_t i = 0; i < N; ++i)
             result[i] = Pb[i] - Pa[i];
         return result;
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <array>
+#include <type_traits>
 
 #include "rational.hpp"
+#include "dyadic.hpp"
 #include "polynomial.hpp"
 #include "gauss.hpp"
+#include "confluent_vandermonde.hpp"
+#include "utility.hpp"
+#include "scheme_builder.hpp"
 
 namespace polysche
 {
@@ -12,35 +17,167 @@ template <
     std::size_t Order,
     typename T = Rational<long long int>
 >
-struct PolynomialScheme
+struct PolynomialScheme : SchemeBuilder<PolynomialScheme<Order, T>, Order, T>
 {
+    using equation_type = std::array<T, Order + 1>;
+
     std::array<std::array<T, Order + 1>, Order + 1> matrix;
     std::size_t index = 0;
 
     constexpr PolynomialScheme() {};
 
-    constexpr auto get_polynomial() const noexcept
+    /// Appends an equation in place (no copy of the scheme)
+    constexpr PolynomialScheme & push_eqn(equation_type const& coeffs) noexcept
     {
-        Polynomial<T, Order, Order + 1> P{};
-        for (std::size_t degree = 0; degree < Order + 1; ++degree)
-            P.coeffs[degree][degree] = T(1);
-        return P;
+        matrix[index] = coeffs;
+        ++index;
+        return *this;
     }
 
-    constexpr auto add_eqn(std::array<T, Order + 1> const& coeffs) const noexcept
+    /// Returns a copy of the scheme with the equation @p k replaced by the given one
+    constexpr auto replace_eqn(std::size_t k, equation_type const& coeffs) const noexcept
     {
         auto PS = *this;
-        PS.matrix[index] = coeffs;
-        ++PS.index;
+        PS.matrix[k] = coeffs;
         return PS;
     }
 
+    /** @brief Interpolation polynomial
+     *
+     * Systems made of Hermite-type constraints (values and successive derivatives at some nodes)
+     * are solved using divided differences, the others using Gauss-Jordan elimination.
+     *
+     * The O(Order^2) detection of such systems (see confluent_vandermonde_nodes) only runs
+     * if some equation may be a derivative (see may_be_confluent, in O(Order)), so that
+     * systems without repeated nodes don't pay for it.
+     */
     constexpr auto solve() const noexcept
     {
         Polynomial<T, Order, Order + 1> P{};
-        P.coeffs = gauss_inv(matrix);
+        if (auto nodes = confluent_nodes(); nodes.is_valid)
+            P.coeffs = confluent_vandermonde_inv(nodes);
+        else
+            P.coeffs = gauss_inv(matrix);
         return P;
     }
+
+    /** @brief true if the linear system of the scheme is regular
+     *
+     * Singular systems are rejected as soon as a column without pivot is found,
+     * without computing the inverse.
+     */
+    constexpr bool is_regular() const noexcept
+    {
+        return confluent_nodes().is_valid or gauss_is_regular(matrix);
+    }
+
+    /** @brief Interpolation polynomial computed using Dyadic arithmetic when possible
+     *
+     * When all the values involved in the resolution have power-of-two denominators
+     * (eg for finite differences with nodes spaced by powers of two), the system is solved
+     * using Dyadic numbers whose normalization is cheaper than for Rational.
+     * Otherwise, it falls back to the resolution using Rational arithmetic: the Dyadic
+     * elimination stops at the first value that is not dyadic (or that overflows) so that
+     * the fallback costs at most one elimination more than solve().
+     */
+    constexpr auto solve_dyadic() const noexcept
+    {
+        static_assert(is_rational_v<T>, "Dyadic resolution needs a scheme of Rational type");
+        using D = Dyadic<rational_value_t<T>>;
+
+        PolynomialScheme<Order, D> PSD{};
+        bool is_dyadic = true;
+        for (std::size_t i = 0; i < index; ++i)
+        {
+            auto eqn = detail::filled_array<Order + 1>(D(0));
+            for (std::size_t j = 0; j < Order + 1; ++j)
+            {
+                eqn[j] = static_cast<D>(matrix[i][j]);
+                is_dyadic = is_dyadic and eqn[j].is_valid();
+            }
+            PSD.push_eqn(eqn);
+        }
+
+        if (is_dyadic)
+        {
+            // Gauss-Jordan elimination (stopping at the first invalid value)
+            // instead of the divided differences of the confluent path, that don't stop early
+            auto result = gauss_inv_checked(PSD.matrix);
+            if (result.is_regular)
+            {
+                Polynomial<T, Order, Order + 1> P{};
+                for (std::size_t i = 0; i < Order + 1; ++i)
+                    for (std::size_t j = 0; j < Order + 1; ++j)
+                        P.coeffs[i][j] = static_cast<T>(result.value[i][j]);
+                return P;
+            }
+        }
+
+        return solve();
+    }
+
+    /// Interpolation polynomial with the regularity status of the linear system
+    constexpr auto solve_checked() const noexcept
+    {
+        SolveResult<Polynomial<T, Order, Order + 1>> result{};
+        if (auto nodes = confluent_nodes(); nodes.is_valid)
+        {
+            result.value.coeffs = confluent_vandermonde_inv(nodes);
+            result.rank = Order + 1;
+            result.is_regular = true;
+        }
+        else
+        {
+            auto inv = gauss_inv_checked(matrix);
+            result.value.coeffs = inv.value;
+            result.rank = inv.rank;
+            result.is_regular = inv.is_regular;
+        }
+        return result;
+    }
+
+private:
+    /// Nodes of the system if it is made of Hermite-type constraints with repeated nodes
+    constexpr ConfluentNodes<T, Order + 1> confluent_nodes() const noexcept
+    {
+        if (not may_be_confluent(matrix))
+            return {};
+        return confluent_vandermonde_nodes(matrix);
+    }
 };
 
-} // namespace polysche
\ No newline at end of file
+/** @brief true if the equation @p k of a solved scheme can be replaced by the given one
+ *
+ * It checks in O(Order) operations that the resulting linear system is still regular.
+ */
+template <
+    typename T,
+    std::size_t Order
+>
+constexpr bool can_replace_eqn(Polynomial<T, Order, Order + 1> const& S, std::size_t k, std::array<T, Order + 1> const& coeffs) noexcept
+{
+    return not (inv_replace_row_pivot(S.coeffs, k, coeffs) == T(0));
+}
+
+/** @brief Replaces the equation @p k of a solved scheme by the given one
+ *
+ * The interpolation polynomial is updated in O(Order^2) operations instead of solving again the linear system,
+ * eg to derive the boundary variants of a scheme:
+ * @code
+ * constexpr auto S = PS.add_eqns(P(-1), P(0), P(1)).solve();
+ * constexpr auto S_neumann = replace_eqn(S, 0, P.derivate()(0));
+ * @endcode
+ * The resulting system must be regular (see can_replace_eqn).
+ */
+template <
+    typename T,
+    std::size_t Order
+>
+constexpr auto replace_eqn(Polynomial<T, Order, Order + 1> const& S, std::size_t k, std::array<T, Order + 1> const& coeffs) noexcept
+{
+    Polynomial<T, Order, Order + 1> P{};
+    P.coeffs = inv_replace_row(S.coeffs, k, coeffs);
+    return P;
+}
+
+} // namespace polysche
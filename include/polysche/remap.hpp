@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "assembly.hpp"
+#include "parallel.hpp"
+#include "polynomial_scheme.hpp"
+#include "solve_batch.hpp"
+
+namespace polysche
+{
+
+namespace detail
+{
+
+/// First cell of the window of Order + 1 cells used to reconstruct the cell i (centered, shifted inside the grid)
+template <std::size_t Order>
+constexpr std::size_t remap_window(std::size_t i, std::size_t cells) noexcept
+{
+    std::size_t const first = (i > Order / 2) ? i - Order / 2 : 0;
+    return std::min(first, cells - (Order + 1));
+}
+
+} // namespace detail
+
+/** @brief Conservative remap operator between two non-matching 1D grids
+ *
+ * On each source cell, the field is reconstructed by the polynomial of degree Order whose averages
+ * on the Order + 1 neighbouring cells are the given ones (window shifted inside the grid at the boundaries).
+ * The average on a target cell is the integral of these reconstructions over its overlaps with the source cells,
+ * divided by its length, so that the remap is conservative and exact for polynomials of degree Order.
+ *
+ * The reconstructions are solved in parallel (see solve_batch), then the weights of each target cell,
+ * that refer to a contiguous range of source cells, are written directly into their place in the CSR matrix.
+ * The matrix is built once and applied to any number of fields (see apply_remap).
+ *
+ * @code
+ * auto const R = make_remap<2>(source_edges, target_edges);
+ * apply_remap(R, source_averages, target_averages);
+ * @endcode
+ *
+ * @param source    Edges of the source cells (increasing, at least Order + 2 values).
+ * @param target    Edges of the target cells (increasing, covered by the source grid).
+ * @param n_threads Number of threads (0 for default_thread_count()).
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+CsrMatrix<Value> make_remap(std::vector<Value> const& source, std::vector<Value> const& target, std::size_t n_threads = 0)
+{
+    assert(source.size() >= Order + 2 && "Not enough source cells for the reconstruction");
+    std::size_t const ns = source.size() - 1;
+    std::size_t const nt = (target.size() > 0) ? target.size() - 1 : 0;
+
+    // Reconstructions in local coordinates (x - source[i]) / h_i
+    std::vector<PolynomialScheme<Order, Value>> schemes(ns);
+    parallel_for(ns, [&] (std::size_t i) {
+        std::size_t const first = detail::remap_window<Order>(i, ns);
+        Value const h = source[i + 1] - source[i];
+        auto& PS = schemes[i];
+        auto const P = PS.get_polynomial();
+        for (std::size_t j = first; j < first + Order + 1; ++j)
+        {
+            Value const a = (source[j] - source[i]) / h;
+            Value const b = (source[j + 1] - source[i]) / h;
+            auto eqn = P.integrate(a, b);
+            for (auto& e : eqn)
+                e /= (b - a);
+            PS.push_eqn(eqn);
+        }
+    }, n_threads, 64);
+
+    std::vector<Polynomial<Value, Order, Order + 1>> reconstructions(ns);
+    solve_batch(schemes.begin(), schemes.end(), reconstructions.begin(), n_threads);
+
+    // Source cells overlapping each target cell and range of the columns of each row
+    std::vector<std::size_t> first_cell(nt), last_cell(nt), first_col(nt);
+    CsrMatrix<Value> R;
+    R.rows = nt;
+    R.cols = ns;
+    R.row_ptr.assign(nt + 1, 0);
+
+    parallel_for(nt, [&] (std::size_t t) {
+        auto const it = std::upper_bound(source.begin(), source.end(), target[t]);
+        std::size_t i = (it == source.begin()) ? 0 : static_cast<std::size_t>(it - source.begin()) - 1;
+        i = std::min(i, ns - 1);
+        std::size_t last = i;
+        while (last + 1 < ns and source[last + 1] < target[t + 1])
+            ++last;
+
+        first_cell[t] = i;
+        last_cell[t] = last;
+        first_col[t] = detail::remap_window<Order>(i, ns);
+        R.row_ptr[t + 1] = detail::remap_window<Order>(last, ns) + Order + 1 - first_col[t];
+    }, n_threads, 256);
+
+    for (std::size_t t = 0; t < nt; ++t)
+        R.row_ptr[t + 1] += R.row_ptr[t];
+    R.col_index.resize(R.row_ptr[nt]);
+    R.values.assign(R.row_ptr[nt], Value(0));
+
+    // Weights: integrals of the reconstructions over the overlaps
+    parallel_for(nt, [&] (std::size_t t) {
+        std::size_t const row = R.row_ptr[t];
+        for (std::size_t k = row; k < R.row_ptr[t + 1]; ++k)
+            R.col_index[k] = first_col[t] + (k - row);
+
+        Value const length = target[t + 1] - target[t];
+        for (std::size_t i = first_cell[t]; i <= last_cell[t]; ++i)
+        {
+            Value const a = std::max(source[i], target[t]);
+            Value const b = std::min(source[i + 1], target[t + 1]);
+            if (not (b > a))
+                continue;
+
+            Value const h = source[i + 1] - source[i];
+            auto const w = reconstructions[i].integrate((a - source[i]) / h, (b - source[i]) / h);
+            std::size_t const offset = row + detail::remap_window<Order>(i, ns) - first_col[t];
+            for (std::size_t j = 0; j < Order + 1; ++j)
+                R.values[offset + j] += w[j] * h / length;
+        }
+    }, n_threads, 256);
+
+    return R;
+}
+
+/** @brief Conservative remap operator between two non-matching 2D rectilinear grids
+ *
+ * Tensor product of the 1D remaps along each direction (see make_remap), for fields stored row-major
+ * (index y * nx + x). Each row of the matrix is the product of a row of each 1D remap,
+ * so that it is written directly into its place.
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+CsrMatrix<Value> make_remap_2d(std::vector<Value> const& source_x, std::vector<Value> const& source_y,
+                               std::vector<Value> const& target_x, std::vector<Value> const& target_y, std::size_t n_threads = 0)
+{
+    auto const Rx = make_remap<Order, Value>(source_x, target_x, n_threads);
+    auto const Ry = make_remap<Order, Value>(source_y, target_y, n_threads);
+
+    CsrMatrix<Value> R;
+    R.rows = Rx.rows * Ry.rows;
+    R.cols = Rx.cols * Ry.cols;
+    R.row_ptr.assign(R.rows + 1, 0);
+    for (std::size_t ty = 0, t = 0; ty < Ry.rows; ++ty)
+        for (std::size_t tx = 0; tx < Rx.rows; ++tx, ++t)
+            R.row_ptr[t + 1] = R.row_ptr[t] + (Ry.row_ptr[ty + 1] - Ry.row_ptr[ty]) * (Rx.row_ptr[tx + 1] - Rx.row_ptr[tx]);
+    R.col_index.resize(R.row_ptr[R.rows]);
+    R.values.resize(R.row_ptr[R.rows]);
+
+    parallel_for(R.rows, [&] (std::size_t t) {
+        std::size_t const ty = t / Rx.rows, tx = t % Rx.rows;
+        std::size_t k = R.row_ptr[t];
+        for (std::size_t ky = Ry.row_ptr[ty]; ky < Ry.row_ptr[ty + 1]; ++ky)
+            for (std::size_t kx = Rx.row_ptr[tx]; kx < Rx.row_ptr[tx + 1]; ++kx, ++k)
+            {
+                R.col_index[k] = Ry.col_index[ky] * Rx.cols + Rx.col_index[kx];
+                R.values[k] = Ry.values[ky] * Rx.values[kx];
+            }
+    }, n_threads, 256);
+
+    return R;
+}
+
+/** @brief Applies a remap operator: out = R in
+ *
+ * The rows are processed in parallel, each row being a dot product with a few contiguous ranges of @p in.
+ */
+template <typename Value>
+void apply_remap(CsrMatrix<Value> const& R, Value const* in, Value* out, std::size_t n_threads = 0)
+{
+    parallel_for(R.rows, [&] (std::size_t t) {
+        Value r = Value(0);
+        for (std::size_t k = R.row_ptr[t]; k < R.row_ptr[t + 1]; ++k)
+            r += R.values[k] * in[R.col_index[k]];
+        out[t] = r;
+    }, n_threads, 1024);
+}
+
+} // namespace polysche
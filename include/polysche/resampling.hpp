@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "rational.hpp"
+#include "polynomial_scheme.hpp"
+#include "ring_buffer.hpp"
+
+namespace polysche
+{
+
+/** @brief Bank of interpolation stencils at the L fractional phases p / L
+ *
+ * The stencil of phase p interpolates at position p / L in the cell of the base sample,
+ * using the samples base + first, ..., base + first + N - 1.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t L
+>
+struct PolyphaseBank
+{
+    std::array<std::array<Value, N>, L> phases{}; ///< Stencil of each phase
+    int first = 0; ///< Position of the first tap relative to the base sample
+};
+
+/** @brief Generates the polyphase bank of the Lagrange interpolation of given order
+ *
+ * The stencils are computed exactly (using Rational) from the scheme interpolating the samples
+ * first, ..., first + Order and converted to @p Value, so that it is best evaluated at compile time:
+ * @code
+ * constexpr auto bank = make_polyphase_bank<3, 3>(); // cubic interpolation at phases 0, 1/3, 2/3
+ * @endcode
+ */
+template <
+    std::size_t Order,
+    std::size_t L,
+    typename Value = double
+>
+constexpr auto make_polyphase_bank(int first = -static_cast<int>(Order) / 2) noexcept
+{
+    using T = Rational<long long int>;
+    constexpr auto PS = PolynomialScheme<Order, T>{};
+    constexpr auto P = PS.get_polynomial();
+    auto const S = PS.add_eqns(Order + 1, [&P, first] (std::size_t j) {
+        return P(first + static_cast<int>(j));
+    }).solve();
+
+    PolyphaseBank<Value, Order + 1, L> bank{};
+    bank.first = first;
+    for (std::size_t p = 0; p < L; ++p)
+    {
+        auto w = S(T(static_cast<long long int>(p), static_cast<long long int>(L)));
+        for (std::size_t j = 0; j < Order + 1; ++j)
+            bank.phases[p][j] = static_cast<Value>(w[j]);
+    }
+    return bank;
+}
+
+/** @brief Streaming resampler by a rational factor L / M
+ *
+ * The output sample n is the interpolation of the input stream at position n * M / L.
+ * The input is given by chunks of arbitrary size, the last samples being kept in a ring buffer,
+ * and each output sample is emitted as soon as the last sample of its stencil is available
+ * (that is with a latency of first + N - 1 input samples).
+ * Input samples before the beginning of the stream are taken as zeros.
+ *
+ * It doesn't allocate any memory.
+ *
+ * @code
+ * StreamingResampler resampler(make_polyphase_bank<3, 3>(), 2); // 3/2 resampling
+ * std::vector<double> out(resampler.max_output(chunk_size));
+ * auto n = resampler.process(chunk.data(), chunk.size(), out.data());
+ * @endcode
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t L
+>
+class StreamingResampler
+{
+public:
+    /** @brief Constructor
+     *
+     * @param bank  Polyphase bank (its last tap must not be before the base sample).
+     * @param m     Decimation factor M.
+     */
+    constexpr StreamingResampler(PolyphaseBank<Value, N, L> const& bank, std::size_t m) noexcept
+        : bank(bank)
+        , m(m)
+        , delay(bank.first + static_cast<long long int>(N))
+    {
+        assert(m > 0 && "Invalid decimation factor");
+        assert(bank.first + static_cast<int>(N) - 1 >= 0 && "The last tap must not be before the base sample");
+    }
+
+    /// Maximal number of output samples produced by a chunk of @p count input samples
+    constexpr std::size_t max_output(std::size_t count) const noexcept
+    {
+        return (count * L + m - 1) / m + 1;
+    }
+
+    /** @brief Processes a chunk of input samples
+     *
+     * @param in    Input samples.
+     * @param count Number of input samples.
+     * @param out   Output samples (of size at least max_output(count)).
+     * @return the number of output samples written.
+     */
+    std::size_t process(Value const* in, std::size_t count, Value* out) noexcept
+    {
+        std::size_t written = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            history.push(in[i]);
+            --delay;
+
+            // Output samples whose stencil ends at the new sample
+            while (delay == 0)
+            {
+                Value const* window = history.window();
+                auto const& w = bank.phases[phase];
+                Value r = Value(0);
+                for (std::size_t j = 0; j < N; ++j)
+                    r += w[j] * window[j];
+                out[written++] = r;
+
+                phase += m;
+                delay += static_cast<long long int>(phase / L);
+                phase %= L;
+            }
+        }
+        return written;
+    }
+
+    /// Restarts the stream
+    constexpr void reset() noexcept
+    {
+        history.clear();
+        phase = 0;
+        delay = bank.first + static_cast<long long int>(N);
+    }
+
+private:
+    PolyphaseBank<Value, N, L> bank;
+    std::size_t m;
+    RingBuffer<Value, N> history{};
+    std::size_t phase = 0; ///< Phase of the next output sample
+    long long int delay; ///< Number of input samples needed before the next output sample
+};
+
+} // namespace polysche
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace polysche
+{
+
+/** @brief Fixed-size history of the last values of a stream
+ *
+ * Each value is stored twice (at positions i and i + Capacity of a buffer of size 2 * Capacity)
+ * so that the last Capacity values are always contiguous, from the oldest to the newest,
+ * and can be read as a stencil window without index wrapping.
+ *
+ * The history is initially filled with zeros and never allocates.
+ */
+template <
+    typename Value,
+    std::size_t Capacity
+>
+struct RingBuffer
+{
+    std::array<Value, 2 * Capacity> data{};
+    std::size_t head = 0; ///< Position of the oldest value
+
+    /// Appends a value (the oldest one being discarded)
+    constexpr void push(Value const& v) noexcept
+    {
+        data[head] = v;
+        data[head + Capacity] = v;
+        head = (head + 1 == Capacity) ? 0 : head + 1;
+    }
+
+    /// Last Capacity values, from the oldest to the newest
+    constexpr Value const* window() const noexcept
+    {
+        return data.data() + head;
+    }
+
+    /// Value pushed @p age steps ago (0 for the newest)
+    constexpr Value const& back(std::size_t age = 0) const noexcept
+    {
+        return data[head + Capacity - 1 - age];
+    }
+
+    /// Resets the history to zeros
+    constexpr void clear() noexcept
+    {
+        for (auto & v : data)
+            v = Value(0);
+        head = 0;
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+};
+
+} // namespace polysche
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "rational.hpp"
+#include "least_squares_scheme.hpp"
+#include "stencil.hpp"
+
+namespace polysche
+{
+
+/** @brief Least-squares polynomial of a Savitzky-Golay filter
+ *
+ * Fit of degree Order on the Window points first, ..., first + Window - 1 relative to the
+ * evaluation point, computed exactly. Its value and derivatives at 0 are the smoothing and
+ * differentiation stencils, centered by default. The edge variants are obtained using
+ * a window shifted inside the domain (eg first = 0 at the left boundary)
+ * or by evaluating the polynomial at another point of the window.
+ */
+template <
+    std::size_t Order,
+    std::size_t Window,
+    typename T = Rational<long long int>
+>
+constexpr auto savitzky_golay(int first = -static_cast<int>(Window) / 2) noexcept
+{
+    auto const LS = LeastSquaresScheme<Order, Window, T>{};
+    auto const P = LS.get_polynomial();
+    return LS.add_eqns(Window, [&P, first] (std::size_t j) {
+        return P(first + static_cast<int>(j));
+    }).solve();
+}
+
+/** @brief Savitzky-Golay filter bank: smoothed value and its first Derivatives derivatives
+ *
+ * The stencils are computed exactly and then converted to @p Value. They can be applied
+ * in one pass using apply_stencils:
+ * @code
+ * constexpr auto SG = make_savitzky_golay<2, 7, 1>(); // smoothing and first derivative, centered
+ * apply_stencils(SG, u, n, {smoothed, derivative});
+ * @endcode
+ *
+ * @param first Position of the first point of the window relative to the evaluation point
+ *              (eg 0 at the left boundary and 1 - Window at the right boundary).
+ */
+template <
+    std::size_t Order,
+    std::size_t Window,
+    std::size_t Derivatives = 0,
+    typename Value = double
+>
+constexpr auto make_savitzky_golay(int first = -static_cast<int>(Window) / 2) noexcept
+{
+    static_assert(Derivatives <= Order, "Derivatives of order greater than the fit are null");
+
+    auto const S = savitzky_golay<Order, Window>(first);
+
+    std::array<Stencil<Value, Window>, Derivatives + 1> bank{};
+    for (std::size_t d = 0; d <= Derivatives; ++d)
+        bank[d] = make_stencil<Value>(S.derivate(d)(0), first);
+    return bank;
+}
+
+} // namespace polysche
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "polynomial.hpp"
+
+namespace polysche
+{
+
+/** @brief Equations builder shared by the schemes (CRTP base)
+ *
+ * The derived scheme only provides push_eqn, that appends an equation in place,
+ * and inherits the canonical polynomial and the copying variants add_eqn and add_eqns.
+ *
+ * @tparam Derived  Scheme type, with a member function Derived & push_eqn(std::array<T, Order + 1> const&).
+ */
+template <
+    typename Derived,
+    std::size_t Order,
+    typename T
+>
+struct SchemeBuilder
+{
+    using equation_type = std::array<T, Order + 1>;
+
+    /// Canonical polynomial whose values, derivatives and integrals are the equations of the scheme
+    constexpr auto get_polynomial() const noexcept
+    {
+        Polynomial<T, Order, Order + 1> P{};
+        for (std::size_t degree = 0; degree < Order + 1; ++degree)
+            P.coeffs[degree][degree] = T(1);
+        return P;
+    }
+
+    /// Returns a copy of the scheme with the given equation appended
+    constexpr Derived add_eqn(equation_type const& coeffs) const noexcept
+    {
+        Derived S = derived();
+        S.push_eqn(coeffs);
+        return S;
+    }
+
+    /** @brief Returns a copy of the scheme with all the given equations appended
+     *
+     * Unlike chaining add_eqn, the scheme is copied only once, whatever the number of equations.
+     */
+    template <
+        typename... Eqns,
+        typename = std::enable_if_t<(std::is_convertible_v<Eqns const&, equation_type> and ...)>
+    >
+    constexpr Derived add_eqns(Eqns const&... eqns) const noexcept
+    {
+        Derived S = derived();
+        (S.push_eqn(eqns), ...);
+        return S;
+    }
+
+    /// Returns a copy of the scheme with the equations of the given array appended
+    template <std::size_t K>
+    constexpr Derived add_eqns(std::array<equation_type, K> const& eqns) const noexcept
+    {
+        Derived S = derived();
+        for (std::size_t i = 0; i < K; ++i)
+            S.push_eqn(eqns[i]);
+        return S;
+    }
+
+    /** @brief Returns a copy of the scheme with @p count equations generated by @p generator
+     *
+     * The generator is called as generator(i) for i in [0, count[ and must return an equation.
+     */
+    template <
+        typename Generator,
+        typename = std::enable_if_t<std::is_invocable_r_v<equation_type, Generator, std::size_t>>
+    >
+    constexpr Derived add_eqns(std::size_t count, Generator && generator) const noexcept
+    {
+        Derived S = derived();
+        for (std::size_t i = 0; i < count; ++i)
+            S.push_eqn(generator(i));
+        return S;
+    }
+
+private:
+    constexpr Derived const& derived() const noexcept
+    {
+        return static_cast<Derived const&>(*this);
+    }
+};
+
+} // namespace polysche
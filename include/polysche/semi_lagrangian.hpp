@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "polynomial.hpp"
+#include "polynomial_scheme.hpp"
+
+namespace polysche
+{
+
+/** @brief Interpolation kernel at departure points of a semi-Lagrangian scheme
+ *
+ * The weight of each tap of the stencil is a polynomial of the fractional offset s in [0, 1[
+ * of the departure point in its cell. These polynomials are the ones of a solved scheme
+ * (see PolynomialScheme::solve) so that the weights at a departure point cost one Horner
+ * evaluation per tap instead of the resolution of a linear system.
+ *
+ * The points are processed by chunks: the weights are first computed for all the points of the chunk
+ * (vectorized across the points), then applied to the gathered values of the field.
+ *
+ * @code
+ * constexpr auto SL = make_semi_lagrangian<3>(); // cubic Lagrange interpolation, taps -1, 0, 1, 2
+ * SL.advect(u, displacements, n, u_new);         // u_new[k] = u(k + displacements[k])
+ * @endcode
+ *
+ * @tparam Value    Value type of the field.
+ * @tparam Degree   Degree of the weight polynomials.
+ * @tparam N        Number of taps.
+ */
+template <
+    typename Value,
+    std::size_t Degree,
+    std::size_t N
+>
+struct SemiLagrangianKernel
+{
+    /// Number of points processed together by the vectorized loops
+    static constexpr std::size_t chunk_size = 64;
+
+    std::array<std::array<Value, Degree + 1>, N> taps{}; ///< Coefficients (by increasing degree) of the weight polynomial of each tap
+    int first = 0; ///< Position of the first tap relative to the cell of the departure point
+
+    constexpr SemiLagrangianKernel() = default;
+
+    /** @brief Kernel from the interpolation polynomial of a scheme
+     *
+     * @param S     Solved scheme whose equation j is the value at first + j.
+     * @param f     Position of the first tap.
+     */
+    template <typename T>
+    constexpr SemiLagrangianKernel(Polynomial<T, Degree, N> const& S, int f) noexcept
+        : first(f)
+    {
+        for (std::size_t j = 0; j < N; ++j)
+            for (std::size_t degree = 0; degree <= Degree; ++degree)
+                taps[j][degree] = static_cast<Value>(S.coeffs[degree][j]);
+    }
+
+    /// Weights of the taps for the fractional offset @p s
+    constexpr std::array<Value, N> weights(Value const& s) const noexcept
+    {
+        std::array<Value, N> w{};
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            Value r = taps[j][Degree];
+            for (std::size_t degree = Degree; degree-- > 0;)
+                r = r * s + taps[j][degree];
+            w[j] = r;
+        }
+        return w;
+    }
+
+    /** @brief Interpolation at given departure points
+     *
+     * The departure point k is at offsets[k] in [0, 1[ in the cell cells[k], so that
+     * result[k] = sum_j w_j(offsets[k]) field[cells[k] + first + j].
+     */
+    void interpolate(Value const* field, std::ptrdiff_t const* cells, Value const* offsets, std::size_t count, Value* result) const noexcept
+    {
+        std::array<std::array<Value, chunk_size>, N> w;
+        for (std::size_t start = 0; start < count; start += chunk_size)
+        {
+            std::size_t const size = (count - start < chunk_size) ? count - start : chunk_size;
+            weights_chunk(offsets + start, size, w);
+            apply_chunk(field, cells + start, w, size, result + start);
+        }
+    }
+
+    /** @brief Interpolation at the departure points of a displaced grid
+     *
+     * The departure point of the point k is k + displacements[k], so that the field must be
+     * readable from floor(k + displacements[k]) + first to floor(k + displacements[k]) + first + N - 1
+     * (eg using ghost cells).
+     */
+    void advect(Value const* field, Value const* displacements, std::size_t count, Value* result) const noexcept
+    {
+        using std::floor;
+
+        std::array<std::array<Value, chunk_size>, N> w;
+        std::array<std::ptrdiff_t, chunk_size> cells;
+        std::array<Value, chunk_size> offsets;
+        for (std::size_t start = 0; start < count; start += chunk_size)
+        {
+            std::size_t const size = (count - start < chunk_size) ? count - start : chunk_size;
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                Value d = floor(displacements[start + k]);
+                cells[k] = static_cast<std::ptrdiff_t>(start + k) + static_cast<std::ptrdiff_t>(d);
+                offsets[k] = displacements[start + k] - d;
+            }
+
+            weights_chunk(offsets.data(), size, w);
+            apply_chunk(field, cells.data(), w, size, result + start);
+        }
+    }
+
+private:
+    /// Weights for (at most chunk_size) offsets, w[j][k] being the weight of tap j for the point k
+    void weights_chunk(Value const* s, std::size_t size, std::array<std::array<Value, chunk_size>, N> & w) const noexcept
+    {
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            auto const& c = taps[j];
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                Value r = c[Degree];
+                for (std::size_t degree = Degree; degree-- > 0;)
+                    r = r * s[k] + c[degree];
+                w[j][k] = r;
+            }
+        }
+    }
+
+    void apply_chunk(Value const* field, std::ptrdiff_t const* cells, std::array<std::array<Value, chunk_size>, N> const& w, std::size_t size, Value* result) const noexcept
+    {
+        for (std::size_t k = 0; k < size; ++k)
+            result[k] = Value(0);
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            Value const* f = field + first + static_cast<std::ptrdiff_t>(j);
+            for (std::size_t k = 0; k < size; ++k)
+                result[k] += w[j][k] * f[cells[k]];
+        }
+    }
+};
+
+/** @brief Semi-Lagrangian kernel of the Lagrange interpolation of given order
+ *
+ * The taps are at first, first + 1, ..., first + Order relative to the cell of the departure point,
+ * centered around the cell by default. The weight polynomials are computed exactly at compile time.
+ */
+template <
+    std::size_t Order,
+    typename Value = double
+>
+constexpr auto make_semi_lagrangian(int first = -static_cast<int>(Order) / 2) noexcept
+{
+    constexpr auto PS = PolynomialScheme<Order>{};
+    constexpr auto P = PS.get_polynomial();
+    auto S = PS.add_eqns(Order + 1, [&P, first] (std::size_t j) {
+        return P(first + static_cast<int>(j));
+    }).solve();
+    return SemiLagrangianKernel<Value, Order, Order + 1>(S, first);
+}
+
+} // namespace polysche
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+
+#include "parallel.hpp"
+
+namespace polysche
+{
+
+/** @brief Solves a batch of schemes in parallel
+ *
+ * Each scheme of [first, last[ is solved (see PolynomialScheme::solve) and @p extract
+ * is applied to the resulting interpolation polynomial (eg to compute a stencil), the result being
+ * written at the same position in the preallocated output.
+ * The output thus doesn't depend on the number of threads nor on the scheduling.
+ *
+ * @code
+ * std::vector<PolynomialScheme<4, double>> schemes = ...; // eg one per cell of a non-uniform grid
+ * std::vector<std::array<double, 5>> stencils(schemes.size());
+ * solve_batch(schemes.begin(), schemes.end(), stencils.begin(), [] (auto const& S) { return S.derivate()(0.); });
+ * @endcode
+ *
+ * @param first, last   Random access range of schemes.
+ * @param out           Random access iterator to the output (of size last - first).
+ * @param extract       Function applied to each solved scheme.
+ * @param n_threads     Number of threads (0 for default_thread_count()).
+ */
+template <
+    typename InputIt,
+    typename OutputIt,
+    typename Extract,
+    typename = std::enable_if_t<not std::is_integral_v<std::decay_t<Extract>>>
+>
+void solve_batch(InputIt first, InputIt last, OutputIt out, Extract && extract, std::size_t n_threads = 0)
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>,
+                  "solve_batch needs random access to the schemes");
+
+    auto count = static_cast<std::size_t>(std::distance(first, last));
+    parallel_for(count, [&] (std::size_t i)
+    {
+        auto offset = static_cast<typename std::iterator_traits<InputIt>::difference_type>(i);
+        out[offset] = extract(first[offset].solve());
+    }, n_threads);
+}
+
+/// Solves a batch of schemes in parallel and writes the interpolation polynomials in order
+template <
+    typename InputIt,
+    typename OutputIt
+>
+void solve_batch(InputIt first, InputIt last, OutputIt out, std::size_t n_threads = 0)
+{
+    solve_batch(first, last, out, [] (auto && S) { return S; }, n_threads);
+}
+
+} // namespace polysche
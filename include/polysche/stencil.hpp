@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace polysche
+{
+
+/** @brief Stencil of N consecutive taps
+ *
+ * The value of the stencil at position i is sum_j weights[j] u[i + first + j].
+ *
+ * @code
+ * constexpr auto S = PS.add_eqns(P(-1), P(0), P(1)).solve();
+ * constexpr auto D = make_stencil(S.derivate()(0), -1); // centered first derivative
+ * apply_stencil(D, u, n, du);
+ * @endcode
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+struct Stencil
+{
+    std::array<Value, N> weights{}; ///< Weight of each tap
+    int first = 0; ///< Position of the first tap relative to the evaluation point
+
+    /// Position of the last tap relative to the evaluation point
+    constexpr int last() const noexcept
+    {
+        return first + static_cast<int>(N) - 1;
+    }
+
+    static constexpr std::size_t size() noexcept
+    {
+        return N;
+    }
+
+    /// Value of the stencil at the position pointed by @p u
+    constexpr Value operator() (Value const* u) const noexcept
+    {
+        Value r = Value(0);
+        for (std::size_t j = 0; j < N; ++j)
+            r += weights[j] * u[first + static_cast<int>(j)];
+        return r;
+    }
+};
+
+/** @brief Stencil from weights of any type convertible to Value (eg Rational)
+ *
+ * @param weights   Weights of the taps (eg a derivative or an integral of a solved scheme).
+ * @param first     Position of the first tap relative to the evaluation point.
+ */
+template <
+    typename Value = double,
+    typename T,
+    std::size_t N
+>
+constexpr Stencil<Value, N> make_stencil(std::array<T, N> const& weights, int first) noexcept
+{
+    Stencil<Value, N> S{};
+    for (std::size_t j = 0; j < N; ++j)
+        S.weights[j] = static_cast<Value>(weights[j]);
+    S.first = first;
+    return S;
+}
+
+/** @brief Applies a stencil on an array
+ *
+ * out[i] = S(in + i) for i in [0, count[, so that @p in must be readable
+ * from S.first to count - 1 + S.last() (eg using ghost cells).
+ * The loop over the taps is the outer one so that the loop over the points is vectorized.
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+void apply_stencil(Stencil<Value, N> const& S, Value const* in, std::size_t count, Value* out) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = Value(0);
+
+    for (std::size_t j = 0; j < N; ++j)
+    {
+        Value const w = S.weights[j];
+        Value const* u = in + S.first + static_cast<int>(j);
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] += w * u[i];
+    }
+}
+
+/** @brief Applies several stencils with the same taps in one pass
+ *
+ * out[k][i] = S[k](in + i) for each stencil k and i in [0, count[, all the stencils
+ * having the same first tap (eg a smoothed value and its derivatives).
+ * Each input value is loaded once for all the stencils.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    std::size_t K
+>
+void apply_stencils(std::array<Stencil<Value, N>, K> const& S, Value const* in, std::size_t count, std::array<Value*, K> const& out) noexcept
+{
+    constexpr std::size_t chunk_size = 64;
+    for (std::size_t k = 1; k < K; ++k)
+        assert(S[k].first == S[0].first && "Fused stencils must have the same taps");
+
+    std::array<std::array<Value, chunk_size>, K> r;
+    for (std::size_t start = 0; start < count; start += chunk_size)
+    {
+        std::size_t const size = (count - start < chunk_size) ? count - start : chunk_size;
+        for (std::size_t k = 0; k < K; ++k)
+            for (std::size_t i = 0; i < size; ++i)
+                r[k][i] = Value(0);
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            Value const* u = in + start + S[0].first + static_cast<int>(j);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                Value const v = u[i];
+                for (std::size_t k = 0; k < K; ++k)
+                    r[k][i] += S[k].weights[j] * v;
+            }
+        }
+
+        for (std::size_t k = 0; k < K; ++k)
+            for (std::size_t i = 0; i < size; ++i)
+                out[k][start + i] = r[k][i];
+    }
+}
+
+/** @brief Applies a stencil on a multi-component field stored as an array of structs
+ *
+ * The field has @p Components values per cell (eg the conserved variables) stored contiguously,
+ * and out[i * Components + c] = sum_j S.weights[j] in[(i + S.first + j) * Components + c].
+ * The same weights apply to all the components, so that the stencil is applied on the flattened
+ * array with a stride of Components between taps: each cell is read once per tap for all its
+ * components and the loop is vectorized across cells and components.
+ */
+template <
+    std::size_t Components,
+    typename Value,
+    std::size_t N
+>
+void apply_stencil_components(Stencil<Value, N> const& S, Value const* in, std::size_t count, Value* out) noexcept
+{
+    std::size_t const size = count * Components;
+    for (std::size_t i = 0; i < size; ++i)
+        out[i] = Value(0);
+
+    for (std::size_t j = 0; j < N; ++j)
+    {
+        Value const w = S.weights[j];
+        Value const* u = in + (S.first + static_cast<int>(j)) * static_cast<std::ptrdiff_t>(Components);
+        for (std::size_t i = 0; i < size; ++i)
+            out[i] += w * u[i];
+    }
+}
+
+/** @brief Applies several stencils with the same taps on a multi-component field in one pass
+ *
+ * Same as apply_stencils for a field stored as an array of structs of @p Components values
+ * (see apply_stencil_components).
+ */
+template <
+    std::size_t Components,
+    typename Value,
+    std::size_t N,
+    std::size_t K
+>
+void apply_stencils_components(std::array<Stencil<Value, N>, K> const& S, Value const* in, std::size_t count, std::array<Value*, K> const& out) noexcept
+{
+    constexpr std::size_t chunk_size = 64 * Components;
+    for (std::size_t k = 1; k < K; ++k)
+        assert(S[k].first == S[0].first && "Fused stencils must have the same taps");
+
+    std::size_t const size = count * Components;
+    std::array<std::array<Value, chunk_size>, K> r;
+    for (std::size_t start = 0; start < size; start += chunk_size)
+    {
+        std::size_t const length = (size - start < chunk_size) ? size - start : chunk_size;
+        for (std::size_t k = 0; k < K; ++k)
+            for (std::size_t i = 0; i < length; ++i)
+                r[k][i] = Value(0);
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            Value const* u = in + start + (S[0].first + static_cast<int>(j)) * static_cast<std::ptrdiff_t>(Components);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                Value const v = u[i];
+                for (std::size_t k = 0; k < K; ++k)
+                    r[k][i] += S[k].weights[j] * v;
+            }
+        }
+
+        for (std::size_t k = 0; k < K; ++k)
+            for (std::size_t i = 0; i < length; ++i)
+                out[k][start + i] = r[k][i];
+    }
+}
+
+} // namespace polysche
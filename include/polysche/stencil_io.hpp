@@ -0,0 +1,303 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+#include "rational.hpp"
+#include "polynomial.hpp"
+#include "stencil_table.hpp"
+#include "utility.hpp"
+#include "mapped_file.hpp"
+
+namespace polysche
+{
+
+/** @brief Header of the binary files of stencil tables and solved schemes
+ *
+ * File layout (native byte order, checked using @c endianness):
+ * - stencil table: header, index of each stencil (uint32, padded to 8 bytes), weights of the distinct stencils (double),
+ * - solved scheme: header, numerator and denominator of each coefficient (int64), degree by degree.
+ */
+struct StencilFileHeader
+{
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t endianness_tag = 0x01020304;
+
+    enum Kind : std::uint32_t
+    {
+        stencil_table = 1,
+        scheme = 2
+    };
+
+    char magic[8] = {'P', 'O', 'L', 'Y', 'S', 'C', 'H', 'E'};
+    std::uint32_t version = current_version;
+    std::uint32_t endianness = endianness_tag;
+    std::uint32_t kind = stencil_table;
+    std::uint32_t value_size = 0; ///< Size in bytes of one stored value
+    std::uint64_t width = 0; ///< Number of weights per stencil (or per degree for a scheme)
+    std::uint64_t count = 0; ///< Number of stencils (or of degrees for a scheme)
+    std::uint64_t distinct = 0; ///< Number of distinct stencils (or of degrees for a scheme)
+    std::uint64_t checksum = 0; ///< FNV-1a hash of the payload
+
+    /// true if the header is compatible with this version of the library
+    bool is_valid(Kind expected_kind) const noexcept
+    {
+        return std::memcmp(magic, StencilFileHeader{}.magic, sizeof(magic)) == 0
+            and version == current_version
+            and endianness == endianness_tag
+            and kind == expected_kind;
+    }
+};
+
+namespace detail
+{
+
+/// FNV-1a 64 bits hash
+inline std::uint64_t fnv1a(void const* data, std::size_t size, std::uint64_t hash = 0xcbf29ce484222325ull) noexcept
+{
+    auto bytes = static_cast<unsigned char const*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// Size in bytes of the index part of a stencil table (padded to 8 bytes)
+inline std::size_t index_bytes(std::size_t count) noexcept
+{
+    return (count * sizeof(std::uint32_t) + 7) / 8 * 8;
+}
+
+} // namespace detail
+
+/** @brief Saves a table of stencils into a binary file
+ *
+ * The file can then be memory-mapped using MappedStencilTable.
+ *
+ * @return false if the file cannot be written.
+ */
+inline bool save_stencil_table(std::string const& path, StencilView<double> const& table)
+{
+    std::uint32_t distinct = 0;
+    std::vector<std::uint32_t> index(table.count);
+    for (std::size_t i = 0; i < table.count; ++i)
+    {
+        index[i] = (table.index != nullptr) ? table.index[i] : static_cast<std::uint32_t>(i);
+        distinct = (index[i] + 1 > distinct) ? index[i] + 1 : distinct;
+    }
+    index.resize(detail::index_bytes(table.count) / sizeof(std::uint32_t), 0);
+
+    StencilFileHeader header;
+    header.kind = StencilFileHeader::stencil_table;
+    header.value_size = sizeof(double);
+    header.width = table.width;
+    header.count = table.count;
+    header.distinct = distinct;
+
+    std::size_t weights_bytes = distinct * table.width * sizeof(double);
+    header.checksum = detail::fnv1a(index.data(), index.size() * sizeof(std::uint32_t));
+    header.checksum = detail::fnv1a(table.weights, weights_bytes, header.checksum);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(std::uint32_t)));
+    file.write(reinterpret_cast<char const*>(table.weights), static_cast<std::streamsize>(weights_bytes));
+    return static_cast<bool>(file);
+}
+
+/** @brief Read-only table of stencils loaded from a binary file
+ *
+ * On POSIX systems, the file is memory-mapped and the stencils are accessed in place
+ * (without copy), so that many processes loading the same file share the same physical pages.
+ * Otherwise, the file is read into memory.
+ *
+ * @code
+ * MappedStencilTable table("stencils.bin");
+ * if (not table.is_valid()) ... // missing, incompatible or corrupted file
+ * auto stencils = table.view();
+ * @endcode
+ */
+class MappedStencilTable
+{
+public:
+    MappedStencilTable() = default;
+
+    /** @brief Loads a table of stencils
+     *
+     * @param path      Path to the file written by save_stencil_table.
+     * @param verify    Verifies the checksum of the file (reads the whole file).
+     *                  The sizes and the index of the stencils are always checked.
+     */
+    explicit MappedStencilTable(std::string const& path, bool verify = true)
+        : file(path)
+    {
+        valid = check(verify);
+    }
+
+    MappedStencilTable(MappedStencilTable const&) = delete;
+    MappedStencilTable& operator= (MappedStencilTable const&) = delete;
+
+    MappedStencilTable(MappedStencilTable && other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedStencilTable& operator= (MappedStencilTable && other) noexcept
+    {
+        if (this != &other)
+        {
+            file = std::move(other.file);
+            valid = other.valid;
+            other.valid = false;
+        }
+        return *this;
+    }
+
+    /// true if the file has been successfully loaded and checked
+    bool is_valid() const noexcept
+    {
+        return valid;
+    }
+
+    /// Header of the loaded file
+    StencilFileHeader const& header() const noexcept
+    {
+        return *reinterpret_cast<StencilFileHeader const*>(file.data());
+    }
+
+    /// View of the stencils (pointing into the mapped file)
+    StencilView<double> view() const noexcept
+    {
+        if (not valid)
+            return {};
+
+        auto const& h = header();
+        auto index = reinterpret_cast<std::uint32_t const*>(file.data() + sizeof(StencilFileHeader));
+        auto weights = reinterpret_cast<double const*>(file.data() + sizeof(StencilFileHeader) + detail::index_bytes(h.count));
+        return {weights, index, static_cast<std::size_t>(h.width), static_cast<std::size_t>(h.count)};
+    }
+
+private:
+    bool check(bool verify) const noexcept
+    {
+        unsigned char const* data = file.data();
+        std::size_t const size = file.size();
+        if (data == nullptr or size < sizeof(StencilFileHeader))
+            return false;
+
+        auto const& h = header();
+        if (not h.is_valid(StencilFileHeader::stencil_table) or h.value_size != sizeof(double))
+            return false;
+
+        // Sizes read from the file, compared to the file size without overflow
+        std::uint64_t const available = size - sizeof(StencilFileHeader);
+        std::uint64_t weights_bytes = 0;
+        if (h.count > available / sizeof(std::uint32_t)
+            or not detail::checked_mul(h.distinct, h.width, weights_bytes)
+            or not detail::checked_mul(weights_bytes, std::uint64_t(sizeof(double)), weights_bytes)
+            or weights_bytes > available)
+            return false;
+
+        std::size_t payload = detail::index_bytes(h.count) + weights_bytes;
+        if (available != payload)
+            return false;
+
+        // Index pointing to missing stencils (always checked since view() trusts it)
+        auto index = reinterpret_cast<std::uint32_t const*>(data + sizeof(StencilFileHeader));
+        for (std::size_t i = 0; i < h.count; ++i)
+            if (index[i] >= h.distinct)
+                return false;
+
+        return not verify or detail::fnv1a(data + sizeof(StencilFileHeader), payload) == h.checksum;
+    }
+
+    MappedFile file; ///< Read-only mapping of the file
+    bool valid = false;
+};
+
+/** @brief Saves a solved scheme (interpolation polynomial of Rational coefficients) into a binary file
+ *
+ * @return false if the file cannot be written.
+ */
+template <
+    typename I,
+    std::size_t Degree,
+    std::size_t N
+>
+bool save_scheme(std::string const& path, Polynomial<Rational<I>, Degree, N> const& S)
+{
+    std::vector<std::int64_t> values;
+    values.reserve(2 * (Degree + 1) * N);
+    for (auto const& row : S.coeffs)
+        for (auto const& c : row)
+        {
+            values.push_back(static_cast<std::int64_t>(c.p));
+            values.push_back(static_cast<std::int64_t>(c.q));
+        }
+
+    StencilFileHeader header;
+    header.kind = StencilFileHeader::scheme;
+    header.value_size = 2 * sizeof(std::int64_t);
+    header.width = N;
+    header.count = Degree + 1;
+    header.distinct = Degree + 1;
+    header.checksum = detail::fnv1a(values.data(), values.size() * sizeof(std::int64_t));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(std::int64_t)));
+    return static_cast<bool>(file);
+}
+
+/** @brief Loads a solved scheme saved by save_scheme
+ *
+ * @return false (leaving @p S unchanged) if the file is missing, corrupted, doesn't match
+ *         the polynomial dimensions or holds a value that doesn't fit in @p I.
+ */
+template <
+    typename I,
+    std::size_t Degree,
+    std::size_t N
+>
+bool load_scheme(std::string const& path, Polynomial<Rational<I>, Degree, N> & S)
+{
+    std::ifstream file(path, std::ios::binary);
+    StencilFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (not file
+        or not header.is_valid(StencilFileHeader::scheme)
+        or header.value_size != 2 * sizeof(std::int64_t)
+        or header.width != N
+        or header.count != Degree + 1)
+        return false;
+
+    std::vector<std::int64_t> values(2 * (Degree + 1) * N);
+    file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(std::int64_t)));
+    if (not file or detail::fnv1a(values.data(), values.size() * sizeof(std::int64_t)) != header.checksum)
+        return false;
+
+    // Values must be representable in I (round trip) and denominators nonzero
+    auto const fits = [] (std::int64_t v) { return static_cast<std::int64_t>(static_cast<I>(v)) == v; };
+
+    // Decoded apart so that S is left unchanged on failure
+    Polynomial<Rational<I>, Degree, N> result;
+    for (std::size_t degree = 0; degree <= Degree; ++degree)
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            auto k = 2 * (degree * N + i);
+            if (values[k + 1] == 0 or not fits(values[k]) or not fits(values[k + 1]))
+                return false;
+            result.coeffs[degree][i] = Rational<I>(static_cast<I>(values[k]), static_cast<I>(values[k + 1]));
+        }
+
+    S = result;
+    return true;
+}
+
+} // namespace polysche
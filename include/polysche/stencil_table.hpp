@@ -0,0 +1,232 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+#include "rational.hpp"
+#include "utility.hpp"
+
+namespace polysche
+{
+
+/** @brief Non-owning view of a table of stencils of the same width
+ *
+ * The weights of the distinct stencils are stored contiguously and an optional
+ * index maps each stencil of the table to one of them (so that identical stencils are stored once).
+ */
+template <typename Value>
+struct StencilView
+{
+    Value const* weights = nullptr; ///< Weights of the distinct stencils (width values each)
+    std::uint32_t const* index = nullptr; ///< Distinct stencil of each stencil of the table (identity if null)
+    std::size_t width = 0; ///< Number of weights per stencil
+    std::size_t count = 0; ///< Number of stencils in the table
+
+    /// Number of stencils in the table
+    constexpr std::size_t size() const noexcept
+    {
+        return count;
+    }
+
+    /// Pointer to the weights of the i-th stencil of the table
+    constexpr Value const* operator[] (std::size_t i) const noexcept
+    {
+        return weights + (index != nullptr ? index[i] : i) * width;
+    }
+};
+
+/** @brief Compact storage of a table of rational stencils
+ *
+ * Each distinct stencil is stored as narrow integer numerators with one shared denominator
+ * (a power of two for most of the finite volume and multiresolution stencils),
+ * identical stencils being stored only once.
+ *
+ * It is meant to be generated at compile time (see make_compact_stencil_table) and decoded
+ * to floating point weights when loaded, so that the decoded table stays small enough
+ * to remain in cache while applying the stencils.
+ *
+ * @tparam Int      Integer type of the numerators (eg std::int16_t or std::int32_t).
+ * @tparam Width    Number of weights per stencil.
+ * @tparam Count    Number of stencils in the table.
+ * @tparam Distinct Maximal number of distinct stencils (storage size of the weights).
+ */
+template <
+    typename Int,
+    std::size_t Width,
+    std::size_t Count,
+    std::size_t Distinct = Count
+>
+struct CompactStencilTable
+{
+    std::array<std::array<Int, Width>, Distinct> numerators{}; ///< Numerators of the distinct stencils (first @c distinct ones)
+    std::array<long long int, Distinct> denominators{}; ///< Shared denominator of each distinct stencil
+    std::array<std::uint32_t, Count> index{}; ///< Distinct stencil of each stencil of the table
+    std::size_t distinct = 0; ///< Number of distinct stencils
+    bool is_valid = true; ///< false if a numerator overflows or doesn't fit in the storage type, or if there are more than Distinct distinct stencils
+
+    /// Weights of the i-th stencil of the table
+    template <typename Value = double>
+    constexpr std::array<Value, Width> decode(std::size_t i) const noexcept
+    {
+        std::array<Value, Width> weights{};
+        auto k = index[i];
+        for (std::size_t j = 0; j < Width; ++j)
+            weights[j] = static_cast<Value>(numerators[k][j]) / static_cast<Value>(denominators[k]);
+        return weights;
+    }
+
+    /// Decodes the weights of the distinct stencils (Width values each)
+    template <typename Value = double>
+    void decode(std::vector<Value> & weights) const
+    {
+        weights.resize(distinct * Width);
+        for (std::size_t k = 0; k < distinct; ++k)
+            for (std::size_t j = 0; j < Width; ++j)
+                weights[k * Width + j] = static_cast<Value>(numerators[k][j]) / static_cast<Value>(denominators[k]);
+    }
+
+    /// View of the table using the decoded weights (see decode)
+    template <typename Value>
+    StencilView<Value> view(std::vector<Value> const& weights) const noexcept
+    {
+        return {weights.data(), index.data(), Width, Count};
+    }
+};
+
+namespace detail
+{
+
+/// Reduced representation of a rational stencil: numerators over the least common denominator
+template <
+    typename I,
+    std::size_t Width
+>
+struct SharedDenominatorStencil
+{
+    std::array<I, Width> numerators{};
+    I denominator = 1;
+    bool is_valid = true; ///< false if the common denominator or a numerator overflows I
+};
+
+/// Numerators of a stencil over the least common multiple of its denominators, with overflow detection
+template <
+    typename I,
+    std::size_t Width
+>
+constexpr SharedDenominatorStencil<I, Width> shared_denominator(std::array<Rational<I>, Width> const& stencil) noexcept
+{
+    SharedDenominatorStencil<I, Width> result{};
+    for (std::size_t j = 0; j < Width and result.is_valid; ++j)
+        result.is_valid = checked_mul(result.denominator / std::gcd(result.denominator, stencil[j].q), stencil[j].q, result.denominator);
+
+    for (std::size_t j = 0; j < Width and result.is_valid; ++j)
+        result.is_valid = checked_mul(stencil[j].p, result.denominator / stencil[j].q, result.numerators[j]);
+
+    return result;
+}
+
+} // namespace detail
+
+/** @brief Number of distinct stencils of a table, ie the storage needed by make_compact_stencil_table
+ *
+ * Stencils are compared by value (Rational values being reduced, that is componentwise).
+ */
+template <
+    typename I,
+    std::size_t Width,
+    std::size_t Count
+>
+constexpr std::size_t count_distinct_stencils(std::array<std::array<Rational<I>, Width>, Count> const& stencils) noexcept
+{
+    std::size_t distinct = 0;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        bool found = false;
+        for (std::size_t k = 0; k < i and not found; ++k)
+        {
+            bool same = true;
+            for (std::size_t j = 0; j < Width and same; ++j)
+                same = stencils[k][j] == stencils[i][j];
+            found = same;
+        }
+        distinct += found ? 0 : 1;
+    }
+    return distinct;
+}
+
+/** @brief Generates the compact storage of a table of rational stencils
+ *
+ * Only @p Distinct stencils are stored (the table being invalid if there are more distinct stencils),
+ * so that the deduplication actually shrinks the table:
+ * @code
+ * constexpr auto stencils = std::array{
+ *     S.integrate({-1, 2}, 0),
+ *     S.integrate(0, {1, 2}),
+ *     S.integrate({-1, 2}, 0),
+ * };
+ * constexpr auto table = make_compact_stencil_table<std::int16_t, count_distinct_stencils(stencils)>(stencils);
+ * std::vector<double> weights;
+ * table.decode(weights);
+ * auto view = table.view(weights);
+ * @endcode
+ */
+template <
+    typename Int,
+    std::size_t Distinct,
+    typename I,
+    std::size_t Width,
+    std::size_t Count
+>
+constexpr auto make_compact_stencil_table(std::array<std::array<Rational<I>, Width>, Count> const& stencils) noexcept
+{
+    CompactStencilTable<Int, Width, Count, Distinct> table{};
+
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        // Shared denominator and narrowed numerators
+        auto const reduced = detail::shared_denominator(stencils[i]);
+        table.is_valid = table.is_valid and reduced.is_valid;
+
+        std::array<Int, Width> numerators{};
+        for (std::size_t j = 0; j < Width; ++j)
+        {
+            I const p = reduced.numerators[j];
+            if (p < static_cast<I>(std::numeric_limits<Int>::min()) or p > static_cast<I>(std::numeric_limits<Int>::max()))
+                table.is_valid = false;
+            numerators[j] = static_cast<Int>(p);
+        }
+        auto const denominator = static_cast<long long int>(reduced.denominator);
+
+        // Searching an identical stencil
+        std::size_t k = 0;
+        while (k < table.distinct)
+        {
+            bool same = table.denominators[k] == denominator;
+            for (std::size_t j = 0; j < Width and same; ++j)
+                same = table.numerators[k][j] == numerators[j];
+            if (same)
+                break;
+            ++k;
+        }
+
+        if (k == table.distinct)
+        {
+            if (k == Distinct)
+            {
+                table.is_valid = false;
+                return table;
+            }
+            table.numerators[k] = numerators;
+            table.denominators[k] = denominator;
+            ++table.distinct;
+        }
+        table.index[i] = static_cast<std::uint32_t>(k);
+    }
+
+    return table;
+}
+
+} // namespace polysche
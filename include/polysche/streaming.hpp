@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "stencil.hpp"
+#include "ring_buffer.hpp"
+
+namespace polysche
+{
+
+/** @brief Streaming application of a stencil
+ *
+ * The input stream is given by chunks of arbitrary size and the last N samples are kept
+ * in a ring buffer, so that an unbounded stream is processed with a bounded memory.
+ * The output sample k (the stencil at the input sample k) is emitted as soon as
+ * the input sample k + S.last() is available, that is with a fixed latency of S.last() samples.
+ * Input samples before the beginning of the stream are taken as zeros.
+ *
+ * Inside a chunk, the stencil is directly applied on the chunk and only its first N - 1 outputs
+ * involve the ring buffer. It doesn't allocate any memory.
+ *
+ * @code
+ * StreamingStencil derivative(make_stencil(S.derivate()(0), -1));
+ * auto n = derivative.process(chunk.data(), chunk.size(), out.data()); // n <= chunk.size()
+ * @endcode
+ */
+template <
+    typename Value,
+    std::size_t N
+>
+class StreamingStencil
+{
+public:
+    /// Constructor (the last tap of the stencil must not be before the evaluation point)
+    constexpr explicit StreamingStencil(Stencil<Value, N> const& S) noexcept
+        : stencil(S)
+    {
+        assert(S.last() >= 0 && "The last tap must not be before the evaluation point");
+    }
+
+    /// Number of input samples between an input sample and the output sample at the same position
+    constexpr std::size_t latency() const noexcept
+    {
+        return static_cast<std::size_t>(stencil.last());
+    }
+
+    /** @brief Processes a chunk of input samples
+     *
+     * @param in    Input samples.
+     * @param count Number of input samples.
+     * @param out   Output samples (of size at least @p count).
+     * @return the number of output samples written.
+     */
+    std::size_t process(Value const* in, std::size_t count, Value* out) noexcept
+    {
+        std::size_t written = 0;
+
+        // Stencils overlapping the previous chunks
+        std::size_t const head = (count < N - 1) ? count : N - 1;
+        for (std::size_t i = 0; i < head; ++i)
+        {
+            history.push(in[i]);
+            if (received++ >= latency())
+                out[written++] = dot(history.window());
+        }
+
+        // Stencils inside the chunk
+        if (head < count)
+        {
+            std::size_t skip = (received >= latency()) ? 0 : latency() - received;
+            skip = (skip < count - head) ? skip : count - head;
+            Value const* window = in + head + skip + 1 - N;
+            std::size_t const size = count - head - skip;
+
+            for (std::size_t i = 0; i < size; ++i)
+                out[written + i] = Value(0);
+            for (std::size_t j = 0; j < N; ++j)
+                for (std::size_t i = 0; i < size; ++i)
+                    out[written + i] += stencil.weights[j] * window[i + j];
+
+            written += size;
+            received += count - head;
+
+            // Last samples of the chunk
+            for (std::size_t i = (count - head > N) ? count - N : head; i < count; ++i)
+                history.push(in[i]);
+        }
+
+        return written;
+    }
+
+    /// Restarts the stream
+    constexpr void reset() noexcept
+    {
+        history.clear();
+        received = 0;
+    }
+
+private:
+    constexpr Value dot(Value const* window) const noexcept
+    {
+        Value r = Value(0);
+        for (std::size_t j = 0; j < N; ++j)
+            r += stencil.weights[j] * window[j];
+        return r;
+    }
+
+    Stencil<Value, N> stencil;
+    RingBuffer<Value, N> history{};
+    std::size_t received = 0; ///< Number of input samples since the beginning of the stream
+};
+
+} // namespace polysche
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace polysche
+{
+
+namespace detail
+{
+
+template <
+    typename T,
+    std::size_t... I
+>
+constexpr std::array<T, sizeof...(I)> filled_array_impl(T const& value, std::index_sequence<I...>) noexcept
+{
+    return {{(static_cast<void>(I), value)...}};
+}
+
+/** @brief Array of N copies of a value, usable in constant expressions
+ *
+ * Local arrays of values that may be Rational must be initialized using this function
+ * instead of being value-initialized (eg std::array<std::array<T, N>, N> c{}):
+ * GCC 12 value-initializes some elements of a local array of arrays of a class type
+ * to null bytes (so a null denominator for a Rational) when the function runs at run time
+ * after having been constant-evaluated in the same translation unit.
+ * Flat local arrays and data members with a default member initializer (eg SolveResult::value)
+ * are not affected, but all the local arrays are initialized this way so that no site
+ * depends on this distinction.
+ *
+ * @code
+ * auto c = filled_array<N>(filled_array<N>(T(0))); // N x N null matrix
+ * @endcode
+ */
+template <
+    std::size_t N,
+    typename T
+>
+constexpr std::array<T, N> filled_array(T const& value) noexcept
+{
+    return filled_array_impl(value, std::make_index_sequence<N>{});
+}
+
+/** @brief Sum of two integers with overflow detection
+ *
+ * @return false if the sum overflows (@p result being then unchanged).
+ */
+template <typename I>
+constexpr bool checked_add(I a, I b, I & result) noexcept
+{
+    constexpr I max = std::numeric_limits<I>::max();
+    constexpr I min = std::numeric_limits<I>::min();
+
+    if ((b > 0) ? a > max - b : a < min - b)
+        return false;
+    result = a + b;
+    return true;
+}
+
+/** @brief Product of two integers with overflow detection
+ *
+ * @return false if the product overflows (@p result being then unchanged).
+ */
+template <typename I>
+constexpr bool checked_mul(I a, I b, I & result) noexcept
+{
+    constexpr I max = std::numeric_limits<I>::max();
+    constexpr I min = std::numeric_limits<I>::min();
+
+    bool overflow = false;
+    if (a != 0 and b != 0)
+    {
+        if (a > 0)
+            overflow = (b > 0) ? a > max / b : b < min / a;
+        else
+            overflow = (b > 0) ? a < min / b : b < max / a;
+    }
+
+    if (overflow)
+        return false;
+    result = a * b;
+    return true;
+}
+
+template <
+    typename T,
+    typename = void
+>
+struct HasIsValid : std::false_type {};
+
+template <typename T>
+struct HasIsValid<T, std::void_t<decltype(std::declval<T const&>().is_valid())>> : std::true_type {};
+
+/// true if a value is valid (eg a Dyadic that is actually dyadic), always true for types without is_valid()
+template <typename T>
+constexpr bool is_valid_value(T const& v) noexcept
+{
+    if constexpr (HasIsValid<T>::value)
+        return v.is_valid();
+    else
+        return true;
+}
+
+} // namespace detail
+
+} // namespace polysche
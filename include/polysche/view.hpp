@@ -0,0 +1,270 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "stencil.hpp"
+
+namespace polysche
+{
+
+/** @brief Non-owning multi-dimensional view of an array (mdspan-like)
+ *
+ * The element of indices (i_0, ..., i_{Rank-1}) is data[sum_d i_d * strides[d]].
+ * The strides may describe a sub-array of a larger one (eg the interior of an array with ghost cells,
+ * see subview) so that a stencil may read outside of the extents of the view.
+ *
+ * @tparam Value    Value type (const-qualified for a read-only view).
+ * @tparam Rank     Number of dimensions.
+ */
+template <
+    typename Value,
+    std::size_t Rank
+>
+struct View
+{
+    Value* data = nullptr;
+    std::array<std::size_t, Rank> extents{}; ///< Number of elements along each dimension
+    std::array<std::ptrdiff_t, Rank> strides{}; ///< Distance between two consecutive elements along each dimension
+
+    /// Element at the given indices (that may be outside of the extents)
+    template <typename... Indices>
+    constexpr Value& operator() (Indices... indices) const noexcept
+    {
+        static_assert(sizeof...(Indices) == Rank, "Wrong number of indices");
+        std::array<std::ptrdiff_t, Rank> i = {static_cast<std::ptrdiff_t>(indices)...};
+        std::ptrdiff_t offset = 0;
+        for (std::size_t d = 0; d < Rank; ++d)
+            offset += i[d] * strides[d];
+        return data[offset];
+    }
+
+    /// Number of elements along the dimension @p d
+    constexpr std::size_t extent(std::size_t d) const noexcept
+    {
+        return extents[d];
+    }
+
+    /// Read-only view of the same elements
+    constexpr operator View<Value const, Rank> () const noexcept
+    {
+        return {data, extents, strides};
+    }
+};
+
+/// View of a contiguous row-major array (the last dimension being contiguous)
+template <
+    typename Value,
+    std::size_t Rank
+>
+constexpr View<Value, Rank> make_view(Value* data, std::array<std::size_t, Rank> const& extents) noexcept
+{
+    View<Value, Rank> view{data, extents, {}};
+    std::ptrdiff_t stride = 1;
+    for (std::size_t d = Rank; d-- > 0;)
+    {
+        view.strides[d] = stride;
+        stride *= static_cast<std::ptrdiff_t>(extents[d]);
+    }
+    return view;
+}
+
+/// View of the elements of @p view starting at the given indices, with the given extents
+template <
+    typename Value,
+    std::size_t Rank
+>
+constexpr View<Value, Rank> subview(View<Value, Rank> const& view, std::array<std::ptrdiff_t, Rank> const& first, std::array<std::size_t, Rank> const& extents) noexcept
+{
+    std::ptrdiff_t offset = 0;
+    for (std::size_t d = 0; d < Rank; ++d)
+        offset += first[d] * view.strides[d];
+    return {view.data + offset, extents, view.strides};
+}
+
+namespace detail
+{
+
+/// Calls f(in_offset, out_offset) for each multi-index over the dimensions not masked by @p skip
+template <
+    std::size_t Rank,
+    typename Function
+>
+void for_each_index(std::array<std::size_t, Rank> const& extents, std::array<bool, Rank> const& skip,
+                    std::array<std::ptrdiff_t, Rank> const& in_strides, std::array<std::ptrdiff_t, Rank> const& out_strides, Function && f)
+{
+    std::array<std::size_t, Rank> index{};
+    for (std::size_t d = 0; d < Rank; ++d)
+        if (not skip[d] and extents[d] == 0)
+            return;
+
+    while (true)
+    {
+        std::ptrdiff_t in_offset = 0, out_offset = 0;
+        for (std::size_t d = 0; d < Rank; ++d)
+        {
+            in_offset += static_cast<std::ptrdiff_t>(index[d]) * in_strides[d];
+            out_offset += static_cast<std::ptrdiff_t>(index[d]) * out_strides[d];
+        }
+        f(in_offset, out_offset);
+
+        // Next multi-index (last dimension first)
+        std::size_t d = Rank;
+        while (d-- > 0)
+        {
+            if (skip[d])
+                continue;
+            if (++index[d] < extents[d])
+                break;
+            index[d] = 0;
+        }
+        if (d == std::size_t(-1))
+            return;
+    }
+}
+
+} // namespace detail
+
+/** @brief Applies a 1D stencil along the dimension @p axis of a multi-dimensional array
+ *
+ * out(i) = sum_j S.weights[j] in(i + (S.first + j) e_axis) for each multi-index i in the extents of @p out,
+ * so that @p in must be readable from S.first to extent - 1 + S.last() along @p axis (see subview).
+ *
+ * If the last dimension is contiguous and different from @p axis, the stencil is applied
+ * across many pencils at once: for a tile of the last dimension, each output row is a weighted sum
+ * of N contiguous input rows, so that the loads are contiguous and the loop is vectorized,
+ * the N rows being reused from cache when moving along @p axis.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    typename InValue,
+    std::size_t Rank
+>
+void apply_stencil_along(Stencil<Value, N> const& S, View<InValue, Rank> const& in, View<Value, Rank> const& out, std::size_t axis,
+                         std::size_t tile = 256)
+{
+    static_assert(std::is_same_v<std::remove_const_t<InValue>, Value>, "Input and output views must have the same value type");
+    assert(axis < Rank && "Invalid axis");
+    constexpr std::size_t c = Rank - 1; // Contiguous dimension
+    std::ptrdiff_t const in_step = in.strides[axis];
+    std::ptrdiff_t const out_step = out.strides[axis];
+    std::size_t const length = out.extents[axis];
+    tile = (tile > 0) ? tile : 1;
+
+    // Pencils along the contiguous dimension
+    if (axis == c and in.strides[c] == 1 and out.strides[c] == 1)
+    {
+        std::array<bool, Rank> skip{};
+        skip[c] = true;
+        detail::for_each_index(out.extents, skip, in.strides, out.strides, [&] (std::ptrdiff_t i, std::ptrdiff_t o) {
+            apply_stencil(S, in.data + i, length, out.data + o);
+        });
+    }
+
+    // Tiles of pencils along a strided dimension
+    else if (axis != c and in.strides[c] == 1 and out.strides[c] == 1)
+    {
+        std::size_t const width = out.extents[c];
+        std::array<bool, Rank> skip{};
+        skip[c] = true;
+        skip[axis] = true;
+        detail::for_each_index(out.extents, skip, in.strides, out.strides, [&] (std::ptrdiff_t i, std::ptrdiff_t o) {
+            for (std::size_t start = 0; start < width; start += tile)
+            {
+                std::size_t const size = (width - start < tile) ? width - start : tile;
+                for (std::size_t k = 0; k < length; ++k)
+                {
+                    Value* w = out.data + o + static_cast<std::ptrdiff_t>(k) * out_step + static_cast<std::ptrdiff_t>(start);
+                    Value const* u = in.data + i + (static_cast<std::ptrdiff_t>(k) + S.first) * in_step + static_cast<std::ptrdiff_t>(start);
+                    for (std::size_t x = 0; x < size; ++x)
+                        w[x] = Value(0);
+                    for (std::size_t j = 0; j < N; ++j)
+                    {
+                        Value const weight = S.weights[j];
+                        Value const* r = u + static_cast<std::ptrdiff_t>(j) * in_step;
+                        for (std::size_t x = 0; x < size; ++x)
+                            w[x] += weight * r[x];
+                    }
+                }
+            }
+        });
+    }
+
+    // Generic strides
+    else
+    {
+        std::array<bool, Rank> skip{};
+        skip[axis] = true;
+        detail::for_each_index(out.extents, skip, in.strides, out.strides, [&] (std::ptrdiff_t i, std::ptrdiff_t o) {
+            for (std::size_t k = 0; k < length; ++k)
+            {
+                Value const* u = in.data + i + (static_cast<std::ptrdiff_t>(k) + S.first) * in_step;
+                Value r = Value(0);
+                for (std::size_t j = 0; j < N; ++j)
+                    r += S.weights[j] * u[static_cast<std::ptrdiff_t>(j) * in_step];
+                out.data[o + static_cast<std::ptrdiff_t>(k) * out_step] = r;
+            }
+        });
+    }
+}
+
+/** @brief Applies a 1D stencil along all the dimensions of a multi-dimensional array (tensor product)
+ *
+ * out(i) = sum_{j_0, ..., j_{Rank-1}} S.weights[j_0] ... S.weights[j_{Rank-1}] in(i + (S.first + j_0, ..., S.first + j_{Rank-1})),
+ * that is the stencil applied dimension by dimension, but fused so that the field is read and written once:
+ * for each output row, the weighted sum of the N^(Rank-1) contributing input rows (contiguous loads)
+ * is accumulated in a row buffer, on which the stencil is then applied along the last dimension.
+ *
+ * @p in must be readable from S.first to extent - 1 + S.last() along each dimension (see subview),
+ * and the last dimension of both views must be contiguous.
+ */
+template <
+    typename Value,
+    std::size_t N,
+    typename InValue,
+    std::size_t Rank
+>
+void apply_stencil_tensor(Stencil<Value, N> const& S, View<InValue, Rank> const& in, View<Value, Rank> const& out)
+{
+    static_assert(std::is_same_v<std::remove_const_t<InValue>, Value>, "Input and output views must have the same value type");
+    constexpr std::size_t c = Rank - 1; // Contiguous dimension
+    assert(in.strides[c] == 1 and out.strides[c] == 1 && "The last dimension must be contiguous");
+
+    std::size_t const width = out.extents[c];
+    std::vector<Value> row(width + N - 1);
+
+    std::size_t combinations = 1; // Contributing input rows
+    for (std::size_t d = 0; d < c; ++d)
+        combinations *= N;
+
+    std::array<bool, Rank> skip{};
+    skip[c] = true;
+    detail::for_each_index(out.extents, skip, in.strides, out.strides, [&] (std::ptrdiff_t i, std::ptrdiff_t o) {
+        for (auto& r : row)
+            r = Value(0);
+
+        for (std::size_t k = 0; k < combinations; ++k)
+        {
+            Value weight = Value(1);
+            std::ptrdiff_t offset = i + S.first;
+            std::size_t m = k;
+            for (std::size_t d = 0; d < c; ++d, m /= N)
+            {
+                weight *= S.weights[m % N];
+                offset += (S.first + static_cast<std::ptrdiff_t>(m % N)) * in.strides[d];
+            }
+
+            InValue* u = in.data + offset;
+            for (std::size_t x = 0; x < row.size(); ++x)
+                row[x] += weight * u[x];
+        }
+
+        apply_stencil(S, row.data() - S.first, width, out.data + o);
+    });
+}
+
+} // namespace polysche
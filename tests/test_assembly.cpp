@@ -0,0 +1,81 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/assembly.hpp>
+#include <polysche/stencil.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::make_stencil;
+    using polysche::assemble_banded;
+    using polysche::assemble_csr;
+
+    // Implicit diffusion operator I - c D2 with one-sided second derivatives at the boundaries
+    double const c = 0.4;
+    auto const interior = make_stencil<double>(std::array{-c, 1. + 2. * c, -c}, -1);
+    auto const left = make_stencil<double>(std::array{1. - c, 2. * c, -c}, 0);
+    auto const right = make_stencil<double>(std::array{-c, 2. * c, 1. - c}, -2);
+
+    std::size_t const n = 5000;
+    auto A = assemble_banded(n, interior, {left}, {right}, 4);
+    auto const C = assemble_csr(n, interior, {left}, {right}, 4);
+    CHECK(A.kl == 2 and A.ku == 2);
+    CHECK(C.size() == 3 * n and C.row_ptr[n] == 3 * n);
+    CHECK(A(0, 0) == 1. - c and A(0, 2) == -c and A(n - 1, n - 3) == -c and A(7, 6) == -c);
+
+    // Both matrices apply the stencils
+    std::vector<double> x(n), y_banded(n), y_csr(n), y_stencil(n);
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = std::sin(0.01 * static_cast<double>(i * i));
+    A.multiply(x.data(), y_banded.data());
+    C.multiply(x.data(), y_csr.data());
+    polysche::apply_stencil(interior, x.data() + 1, n - 2, y_stencil.data() + 1);
+    y_stencil[0] = left(x.data());
+    y_stencil[n - 1] = right(x.data() + n - 1);
+
+    // Same values up to rounding (the compiler may contract the operations differently)
+    auto close = [] (double u, double v) { return std::abs(u - v) <= 1e-13 * (1. + std::abs(v)); };
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i)
+        same = same and close(y_banded[i], y_stencil[i]) and close(y_csr[i], y_stencil[i]);
+    CHECK(same);
+
+    // Banded LU solve
+    std::vector<std::size_t> pivots;
+    CHECK(polysche::banded_lu(A, pivots));
+    polysche::banded_lu_solve(A, pivots, y_banded.data());
+    double error = 0.;
+    for (std::size_t i = 0; i < n; ++i)
+        error = std::max(error, std::abs(y_banded[i] - x[i]));
+    std::cout << "LU error = " << error << std::endl;
+    CHECK(error < 1e-12);
+
+    // Partial pivoting: null diagonal on the first rows
+    {
+    auto const S = make_stencil<double>(std::array{1., 0., 1.}, -1);
+    auto const L = make_stencil<double>(std::array{0., 1., 2.}, 0);
+    auto B = assemble_banded(8, S, {L}, {make_stencil<double>(std::array{1., 2., 3.}, -2)});
+    std::vector<double> u{1., 2., 3., 4., 5., 6., 7., 8.}, v(8);
+    B.multiply(u.data(), v.data());
+    CHECK(polysche::banded_lu(B, pivots));
+    CHECK(pivots[0] == 1);
+    polysche::banded_lu_solve(B, pivots, v.data());
+    bool ok = true;
+    for (std::size_t i = 0; i < 8; ++i)
+        ok = ok and std::abs(v[i] - u[i]) < 1e-12;
+    CHECK(ok);
+    }
+
+    // Singular matrix
+    {
+    auto const S = make_stencil<double>(std::array{1., -2., 1.}, -1);
+    auto B = assemble_banded(6, S, {make_stencil<double>(std::array{1., -1., 0.}, 0)}, {make_stencil<double>(std::array{0., -1., 1.}, -2)});
+    CHECK(not polysche::banded_lu(B, pivots));
+    }
+
+    return return_code();
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/barycentric.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+    using polysche::make_barycentric;
+
+    // Exact stencils compared to the resolution of the scheme (unordered nodes)
+    {
+    using T = Rational<long long int>;
+    constexpr auto PS = PolynomialScheme<3>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto PS1 = PS.add_eqns(P(2), P(-1), P(0), P(1));
+    constexpr auto B = make_barycentric(PS1);
+    constexpr auto S = PS1.solve();
+    static_assert(B.is_valid);
+
+    constexpr auto l = B.stencil(T(1, 3));
+    std::cout << "l(1/3) = " << l << std::endl;
+    CHECK(l == S(T(1, 3)));
+    CHECK(B.stencil(T(-7, 5)) == S(T(-7, 5)));
+    CHECK(B.stencil(T(0)) == S(T(0)));
+    CHECK(B(T(1, 2), {8, -1, 0, 1}) == T(1, 8));
+    }
+
+    // Schemes that are not made of distinct point evaluations
+    {
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    CHECK(not make_barycentric(PS.add_eqns(P(-1), P(0), P.derivate()(0))).is_valid);
+    CHECK(not make_barycentric(PS.add_eqns(P.integrate(-1, 0), P.integrate(0, 1), P.integrate(1, 2))).is_valid);
+    }
+
+    // Many targets in double precision
+    {
+    std::array<double, 5> x = {-2., -1., 0., 1., 2.};
+    polysche::BarycentricInterpolant<double, 5> B(x);
+    CHECK(B.is_valid);
+
+    constexpr std::size_t count = 150;
+    std::vector<double> targets(count);
+    for (std::size_t k = 0; k < count; ++k)
+        targets[k] = -2.5 + 5. * static_cast<double>(k) / static_cast<double>(count - 1);
+
+    std::vector<double> stencils(5 * count);
+    B.stencils(targets.data(), count, stencils.data());
+
+    // u(x) = x^4 - x is reproduced exactly by the interpolant
+    std::array<double, 5> u;
+    for (std::size_t i = 0; i < 5; ++i)
+        u[i] = std::pow(x[i], 4) - x[i];
+
+    std::vector<double> values(count);
+    B.evaluate(u, targets.data(), count, values.data());
+
+    bool ok = true;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        double t = targets[k];
+        double expected = std::pow(t, 4) - t;
+        double v = 0.;
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            v += stencils[i * count + k] * u[i];
+            ok = ok and stencils[i * count + k] == B.stencil(t)[i];
+        }
+        ok = ok and std::abs(v - expected) < 1e-12 * (1. + std::abs(expected));
+        ok = ok and std::abs(values[k] - expected) < 1e-12 * (1. + std::abs(expected));
+    }
+    CHECK(ok);
+
+    polysche::BarycentricInterpolant<double, 3> B2(std::array{0., 1., 0.});
+    CHECK(not B2.is_valid);
+    }
+
+    return return_code();
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+
+#include <polysche/confluent_vandermonde.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/gauss.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+    using polysche::confluent_vandermonde_nodes;
+    using polysche::confluent_vandermonde_inv;
+    using polysche::gauss_inv;
+
+    {
+    std::cout << "Distinct nodes:" << std::endl;
+    constexpr auto PS = PolynomialScheme<3>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto A = PS.add_eqns(P(-1), P(0), P(Rational(1, 2)), P(2)).matrix;
+    constexpr auto nodes = confluent_vandermonde_nodes(A);
+    CHECK(nodes.is_valid);
+    constexpr auto iA = confluent_vandermonde_inv(nodes);
+    std::cout << "inv(A) = " << iA << std::endl;
+    CHECK(iA == gauss_inv(A));
+    CHECK(not polysche::may_be_confluent(A)); // No repeated nodes: solve() skips the detection
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Higher order Hermite spline (unordered constraints):" << std::endl;
+    constexpr auto PS = PolynomialScheme<5>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto A = PS
+        .add_eqn(P.derivate(2)(1))
+        .add_eqn(P(0))
+        .add_eqn(P.derivate()(1))
+        .add_eqn(P(1))
+        .add_eqn(P.derivate()(0))
+        .add_eqn(P.derivate(2)(0))
+        .matrix;
+    constexpr auto nodes = confluent_vandermonde_nodes(A);
+    CHECK(nodes.is_valid);
+    constexpr auto iA = confluent_vandermonde_inv(nodes);
+    std::cout << "inv(A) = " << iA << std::endl;
+    CHECK(iA == gauss_inv(A));
+    CHECK(polysche::may_be_confluent(A));
+    CHECK(PS.add_eqns(A[0], A[1], A[2], A[3], A[4], A[5]).solve().coeffs == iA);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Taylor expansion at a single node:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto A = PS.add_eqns(P(2), P.derivate()(2), P.derivate(2)(2)).matrix;
+    constexpr auto nodes = confluent_vandermonde_nodes(A);
+    CHECK(nodes.is_valid);
+    CHECK(confluent_vandermonde_inv(nodes) == gauss_inv(A));
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Non Hermite constraints:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+
+    // Finite volume
+    constexpr auto A1 = PS
+        .add_eqn(P.integrate({-3, 2}, {-1, 2}))
+        .add_eqn(P.integrate({-1, 2}, { 1, 2}))
+        .add_eqn(P.integrate({ 1, 2}, { 3, 2}))
+        .matrix;
+    CHECK(not confluent_vandermonde_nodes(A1).is_valid);
+
+    // Derivative without value at the same node (Birkhoff interpolation)
+    constexpr auto A2 = PS.add_eqns(P.derivate()(0), P(1), P(2)).matrix;
+    CHECK(not confluent_vandermonde_nodes(A2).is_valid);
+
+    // Duplicated constraint
+    constexpr auto A3 = PS.add_eqns(P(0), P(1), P(1)).matrix;
+    CHECK(not confluent_vandermonde_nodes(A3).is_valid);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Run time evaluation after a constant evaluation:" << std::endl;
+    constexpr auto PS = PolynomialScheme<3>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto A = PS.add_eqns(P(0), P(1), P(2), P(3)).matrix;
+    constexpr auto iA = confluent_vandermonde_inv(confluent_vandermonde_nodes(A));
+
+    // Same system at run time (the nodes being unknown at compile time)
+    volatile int shift = 0;
+    auto const B = PS.add_eqns(P(shift), P(shift + 1), P(shift + 2), P(shift + 3)).matrix;
+    auto const iB = confluent_vandermonde_inv(confluent_vandermonde_nodes(B));
+    bool valid = true;
+    for (auto const& row : iB)
+        for (auto const& v : row)
+            valid = valid and v.is_valid();
+    CHECK(valid);
+    CHECK(iB == iA);
+    std::cout << std::endl;
+    }
+
+    return return_code();
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <limits>
+
+#include <polysche/dyadic.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using T = long long int;
+    using polysche::Dyadic;
+    using polysche::Rational;
+    using polysche::PolynomialScheme;
+    using polysche::is_dyadic_v;
+
+    // Construction and normalization
+    {
+    constexpr Dyadic<T> a(12);
+    CHECK(is_dyadic_v<decltype(a)>);
+    CHECK(a.is_valid() and not a.is_zero());
+    CHECK(a.m == 3 and a.e == 2);
+    CHECK(static_cast<double>(a) == 12.);
+
+    constexpr Dyadic<T> b(-6, -3);
+    CHECK(b.m == -3 and b.e == -2);
+    CHECK(static_cast<double>(b) == -0.75);
+    CHECK(signbit(b) and abs(b) == Dyadic<T>(3, -2));
+
+    constexpr Dyadic<T> z(0, 5);
+    CHECK(z.is_zero() and z.e == 0 and z == 0);
+    }
+
+    // Conversion from and to Rational
+    {
+    constexpr auto a = static_cast<Dyadic<T>>(Rational<T>(35, 65536));
+    CHECK(a.is_valid() and a.m == 35 and a.e == -16);
+    CHECK(static_cast<Rational<T>>(a) == Rational<T>(35, 65536));
+
+    constexpr auto b = static_cast<Dyadic<T>>(Rational<T>(1, 3));
+    CHECK(not b.is_valid());
+    }
+
+    // Arithmetic
+    {
+    constexpr Dyadic<T> a(3, -1); // 3/2
+    constexpr Dyadic<T> b(5, -2); // 5/4
+    CHECK(a + b == Dyadic<T>(11, -2));
+    CHECK(a - b == Dyadic<T>(1, -2));
+    CHECK(a * b == Dyadic<T>(15, -3));
+    CHECK(a * 2 == 3 and 2 * a == 3);
+    CHECK(a / Dyadic<T>(3, 2) == Dyadic<T>(1, -3));
+    CHECK(not (a / b).is_valid());
+    CHECK(not (a / 0).is_valid());
+    CHECK(not ((a / b) + a).is_valid());
+    CHECK(b < a and a > b and not (a < b) and -1 < b);
+    }
+
+    // Overflows
+    {
+    constexpr T max = std::numeric_limits<T>::max();
+    constexpr Dyadic<T> a(3, -40);
+    constexpr Dyadic<T> b(1, 40);
+    CHECK(not (a + b).is_valid()); // shift of 80 bits
+    CHECK(not (b - a).is_valid());
+    CHECK(not (a + Dyadic<T>(1, 23)).is_valid()); // 3 + 2^63
+    CHECK((a + Dyadic<T>(1, 21)) == Dyadic<T>(3 + (T(1) << 61), -40));
+    CHECK(not (Dyadic<T>(max) + Dyadic<T>(max)).is_valid());
+    CHECK(not (Dyadic<T>(max) * 3).is_valid());
+    CHECK((Dyadic<T>(max) * 1) == max);
+    CHECK(0 + b == b and a + 0 == a and Dyadic<T>(0) - b == Dyadic<T>(-1, 40));
+
+    // Comparisons whose difference overflows
+    CHECK(a < b and b > a and Dyadic<T>(-1, 40) < a and a > Dyadic<T>(-1, 40) and not (b < a) and not (a > b));
+    CHECK(Dyadic<T>(-max) < Dyadic<T>(max) and Dyadic<T>(max) > Dyadic<T>(-max));
+    CHECK(Dyadic<T>(max - 2) < Dyadic<T>(max) and Dyadic<T>(-max) < Dyadic<T>(2 - max));
+    CHECK(Dyadic<T>(max) < Dyadic<int>(1, 70) and Dyadic<int>(-1, 70) < Dyadic<T>(-max));
+    CHECK(Dyadic<T>(3) > Dyadic<T>(1, 1) and Dyadic<T>(5, -1) < Dyadic<T>(3) and Dyadic<T>(-5, -1) > Dyadic<T>(-3));
+    CHECK(not (b < b) and not (b > b) and not (Dyadic<T>(0) < 0) and Dyadic<T>(0) > Dyadic<T>(-1, 40));
+    CHECK(not ((b / 3) < b) and not ((b / 3) > b) and not (b < (b / 3)));
+    }
+
+    // Solving a scheme with Dyadic arithmetic
+    {
+    std::cout << "Finite differences of order 2:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto PS_fd = PS.add_eqns(P(-1), P(0), P(1));
+    constexpr auto S = PS_fd.solve_dyadic();
+    std::cout << "S = " << S << std::endl;
+    CHECK(S.coeffs == PS_fd.solve().coeffs);
+
+    std::cout << "Finite differences with Dyadic values:" << std::endl;
+    constexpr auto PSD = PolynomialScheme<2, Dyadic<T>>{};
+    constexpr auto PD = PSD.get_polynomial();
+    constexpr auto SD = PSD.add_eqns(PD(-1), PD(0), PD(1)).solve();
+    std::cout << "SD = " << SD << std::endl;
+    std::cout << "SD'(1/2) = " << SD.derivate()(Dyadic<T>(1, -1)) << std::endl;
+    CHECK(SD.derivate()(Dyadic<T>(1, -1))[2] == 1);
+
+    std::cout << "Finite volumes of order 2 (fallback to Rational):" << std::endl;
+    constexpr auto PS_fv = PS.add_eqns(
+        P.integrate({-3, 2}, {-1, 2}),
+        P.integrate({-1, 2}, { 1, 2}),
+        P.integrate({ 1, 2}, { 3, 2})
+    );
+    constexpr auto S_fv = PS_fv.solve_dyadic();
+    std::cout << "S = " << S_fv << std::endl;
+    CHECK(S_fv.coeffs == PS_fv.solve().coeffs);
+
+    std::cout << "Non-dyadic inverse of a dyadic matrix (fallback to Rational):" << std::endl;
+    constexpr auto PS_3 = PS.add_eqns(P(-1), P(0), P(2));
+    constexpr auto S_3 = PS_3.solve_dyadic();
+    std::cout << "S = " << S_3 << std::endl;
+    CHECK(S_3.coeffs == PS_3.solve().coeffs);
+    CHECK(not polysche::gauss_inv_checked(PolynomialScheme<2, Dyadic<T>>{}.add_eqns(PD(-1), PD(0), PD(2)).matrix).is_regular);
+    std::cout << std::endl;
+    }
+
+    return return_code();
+}
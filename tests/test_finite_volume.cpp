@@ -0,0 +1,156 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/finite_volume.hpp>
+#include <polysche/stencil.hpp>
+#include <polysche/view.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::make_face_reconstruction;
+    using polysche::make_face_states;
+    using polysche::flux_divergence;
+
+    // Classical third order reconstructions
+    {
+    constexpr auto states = make_face_states<2>();
+    std::cout << "left = " << states[0].weights << ", right = " << states[1].weights << std::endl;
+    CHECK(states[0].first == -2 and states[1].first == -1);
+    CHECK((states[0].weights == std::array{-1. / 6, 5. / 6, 1. / 3}));
+    CHECK((states[1].weights == std::array{1. / 3, 5. / 6, -1. / 6}));
+
+    constexpr auto centered = make_face_states<3>();
+    CHECK(centered[0].first == -2 and centered[0].weights == centered[1].weights);
+    CHECK((centered[0].weights == std::array{-1. / 12, 7. / 12, 7. / 12, -1. / 12}));
+    }
+
+    // Burgers fluxes of cell averages of a quadratic function (exact reconstruction)
+    constexpr std::size_t n = 1000;
+    constexpr std::size_t ghosts = 3;
+    constexpr auto states = make_face_states<2>();
+    auto primitive = [] (double x) { return 1e-6 * x * x * x / 3. + 0.5 * x; }; // u(x) = 1e-6 x^2 + 1/2
+    auto u = [] (double x) { return 1e-6 * x * x + 0.5; };
+
+    std::vector<double> averages(n + 2 * ghosts);
+    for (std::size_t i = 0; i < averages.size(); ++i)
+    {
+        double a = static_cast<double>(i) - static_cast<double>(ghosts);
+        averages[i] = primitive(a + 1.) - primitive(a);
+    }
+
+    auto burgers = [] (double ul, double ur) {
+        double const s = 0.5 * (ul + ur);
+        return (s > 0. ? ul * ul : ur * ur) / 2.;
+    };
+
+    std::vector<double> div(n);
+    flux_divergence(states[0], states[1], burgers, averages.data() + ghosts, n, div.data());
+
+    bool ok = true;
+    double sum = 0.;
+    for (std::size_t c = 0; c < n; ++c)
+    {
+        double x = static_cast<double>(c);
+        double expected = (u(x + 1.) * u(x + 1.) - u(x) * u(x)) / 2.;
+        ok = ok and std::abs(div[c] - expected) < 1e-12;
+        sum += div[c];
+    }
+    CHECK(ok);
+
+    // Conservation: the divergence telescopes to the difference of the boundary fluxes
+    double boundary = (u(static_cast<double>(n)) * u(static_cast<double>(n)) - u(0.) * u(0.)) / 2.;
+    CHECK(std::abs(sum - boundary) < 1e-10);
+
+    // Linear upwind flux is the difference of the face reconstructions
+    {
+    std::vector<double> div_linear(n), ul(n + 1);
+    flux_divergence(states[0], states[1], [] (double l, double) { return 2. * l; }, averages.data() + ghosts, n, div_linear.data());
+    polysche::apply_stencil(states[0], averages.data() + ghosts, n + 1, ul.data());
+    bool same = true;
+    for (std::size_t c = 0; c < n; ++c)
+        same = same and div_linear[c] == 2. * ul[c + 1] - 2. * ul[c];
+    CHECK(same);
+    }
+
+    // Upwind-biased states blended by the sign of the velocity
+    {
+    constexpr auto upwind = polysche::make_upwind_states<2>();
+    CHECK(upwind[0].first == states[0].first and upwind[0].weights == states[0].weights);
+    constexpr auto upwind1 = polysche::make_upwind_states<1>();
+    CHECK(upwind1[0].first == -2 and upwind1[1].first == 0);
+    CHECK((upwind1[0].weights == std::array{-0.5, 1.5} and upwind1[1].weights == std::array{1.5, -0.5}));
+
+    std::vector<double> velocity(n + 1);
+    for (std::size_t f = 0; f <= n; ++f)
+        velocity[f] = std::sin(0.3 * static_cast<double>(f));
+
+    std::vector<double> s(n + 1), div_upwind(n);
+    polysche::upwind_states(upwind[0], upwind[1], velocity.data(), averages.data() + ghosts, n + 1, s.data());
+    polysche::upwind_divergence(upwind[0], upwind[1], velocity.data(), averages.data() + ghosts, n, div_upwind.data());
+
+    // Same values up to rounding (the compiler may contract the operations differently)
+    auto close = [] (double u, double v) { return std::abs(u - v) <= 1e-13 * (1. + std::abs(v)); };
+    bool same = true;
+    for (std::size_t f = 0; f <= n; ++f)
+    {
+        auto const& S = (velocity[f] >= 0.) ? upwind[0] : upwind[1];
+        same = same and close(s[f], S(averages.data() + ghosts + f));
+    }
+    for (std::size_t c = 0; c < n; ++c)
+        same = same and close(div_upwind[c], velocity[c + 1] * s[c + 1] - velocity[c] * s[c]);
+    CHECK(same);
+    }
+
+    // Conversions between cell averages and point values
+    {
+    constexpr auto A2P = polysche::make_average_to_point<2>();
+    constexpr auto P2A = polysche::make_point_to_average<2>();
+    CHECK(A2P.first == -1 and P2A.first == -1);
+    CHECK((A2P.weights == std::array{-1. / 24, 13. / 12, -1. / 24}));
+    CHECK((P2A.weights == std::array{1. / 24, 11. / 12, 1. / 24}));
+
+    constexpr auto A2P4 = polysche::make_average_to_point<4>();
+    CHECK((A2P4.weights == std::array{3. / 640, -29. / 480, 1067. / 960, -29. / 480, 3. / 640}));
+
+    // 2D field of degree 2 in each direction: f(x, y) = x^2 y^2 + x y on the cells centered on integers
+    std::size_t const nx = 7, ny = 5, g = 1;
+    auto f = [] (double x, double y) { return x * x * y * y + x * y; };
+    auto average = [] (double x, double y) { return (x * x + 1. / 12) * (y * y + 1. / 12) + x * y; };
+
+    std::vector<double> averages2d((ny + 2 * g) * (nx + 2 * g)), values2d(averages2d.size());
+    for (std::size_t j = 0; j < ny + 2 * g; ++j)
+        for (std::size_t i = 0; i < nx + 2 * g; ++i)
+        {
+            double const x = static_cast<double>(i) - 3, y = static_cast<double>(j) - 2;
+            averages2d[j * (nx + 2 * g) + i] = average(x, y);
+            values2d[j * (nx + 2 * g) + i] = f(x, y);
+        }
+
+    auto const full = polysche::make_view(averages2d.data(), std::array<std::size_t, 2>{ny + 2 * g, nx + 2 * g});
+    auto const full_values = polysche::make_view(values2d.data(), std::array<std::size_t, 2>{ny + 2 * g, nx + 2 * g});
+    std::array<std::ptrdiff_t, 2> const interior_first{1, 1};
+    std::array<std::size_t, 2> const interior_extents{ny, nx};
+
+    std::vector<double> points(ny * nx), back(ny * nx);
+    auto const P = polysche::make_view(points.data(), interior_extents);
+    auto const B = polysche::make_view(back.data(), interior_extents);
+    polysche::apply_stencil_tensor(A2P, polysche::View<double const, 2>(polysche::subview(full, interior_first, interior_extents)), P);
+    polysche::apply_stencil_tensor(P2A, polysche::View<double const, 2>(polysche::subview(full_values, interior_first, interior_extents)), B);
+
+    bool exact = true;
+    for (std::size_t j = 0; j < ny; ++j)
+        for (std::size_t i = 0; i < nx; ++i)
+        {
+            double const x = static_cast<double>(i) - 2, y = static_cast<double>(j) - 1;
+            exact = exact and std::abs(P(j, i) - f(x, y)) < 1e-12;
+            exact = exact and std::abs(B(j, i) - average(x, y)) < 1e-12;
+        }
+    CHECK(exact);
+    }
+
+    return return_code();
+}
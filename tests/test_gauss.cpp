@@ -2,6 +2,7 @@
 #include <array>
 
 #include <polysche/gauss.hpp>
+#include <polysche/check_inverse.hpp>
 #include <polysche/rational.hpp>
 #include "utils.hpp"
 
@@ -10,6 +11,13 @@ int main()
     using polysche::Rational;
     using polysche::gauss_solve;
     using polysche::gauss_inv;
+    using polysche::inv_replace_row;
+    using polysche::inv_replace_row_pivot;
+    using polysche::gauss_inv_checked;
+    using polysche::gauss_solve_checked;
+    using polysche::gauss_is_regular;
+    using polysche::gauss_rank;
+    using polysche::check_inverse;
     
     using T = Rational<int>;
     constexpr std::array<std::array<T, 3>, 3> A{{{1, -1, 1}, {1, 0, 0}, {1, 1, 1}}};
@@ -20,5 +28,46 @@ int main()
     constexpr auto iA = gauss_inv(A);
     std::cout << "inv(A) = " << iA << std::endl;
 
-    return 0;
+    // Replacing a row using Sherman-Morrison update
+    {
+    constexpr std::array<std::array<T, 3>, 3> B{{{0, 1, 0}, {1, 0, 0}, {1, 1, 1}}};
+    constexpr auto iB = inv_replace_row(iA, 0, B[0]);
+    std::cout << "inv(B) = " << iB << std::endl;
+    CHECK(iB == gauss_inv(B));
+
+    constexpr std::array<T, 3> singular_row = {1, 0, 0};
+    CHECK(inv_replace_row_pivot(iA, 0, singular_row) == 0);
+    }
+
+    // Singular matrices
+    {
+    constexpr std::array<std::array<T, 3>, 3> S1{{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}};
+    constexpr std::array<std::array<T, 3>, 3> S2{{{0, 1, 2}, {0, 3, 4}, {0, 5, 6}}};
+    CHECK(gauss_rank(S1) == 2);
+    CHECK(gauss_rank(S2) == 2);
+    CHECK(not gauss_is_regular(S1));
+    CHECK(not gauss_is_regular(S2));
+    CHECK(gauss_is_regular(A));
+
+    constexpr auto iS2 = gauss_inv_checked(S2);
+    CHECK(not iS2.is_regular and iS2.rank == 0); // Early exit on the first column
+    CHECK(not gauss_solve_checked(S1, b));
+
+    constexpr auto iA_checked = gauss_inv_checked(A);
+    CHECK(iA_checked and iA_checked.rank == 3 and iA_checked.value == iA);
+    }
+
+    // Fingerprint check of an inverse
+    {
+    constexpr std::array<std::array<T, 3>, 3> wrong_iA{{{0, 1, 0}, {-1, 0, 1}, {1, -1, 1}}};
+    CHECK(check_inverse(A, iA));
+    CHECK(check_inverse(A, iA, 42));
+    CHECK(not check_inverse(A, wrong_iA));
+
+    constexpr std::array<std::array<double, 3>, 3> Ad{{{1, -1, 1}, {1, 0, 0}, {1, 1, 1}}};
+    constexpr auto iAd = gauss_inv(Ad);
+    CHECK(check_inverse(Ad, iAd));
+    }
+
+    return return_code();
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <array>
+#include <cmath>
+
+#include <polysche/gauss_batch.hpp>
+#include <polysche/gauss.hpp>
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::gauss_solve;
+    using polysche::gauss_inv;
+    using polysche::gauss_solve_batch;
+    using polysche::gauss_inv_batch;
+
+    constexpr std::size_t N = 5;
+    constexpr std::size_t B = 8;
+    using Matrix = std::array<std::array<double, N>, N>;
+    using Vector = std::array<double, N>;
+
+    // Vandermonde-like matrices on shifted nodes (some lanes requiring pivoting)
+    std::array<Matrix, B> A;
+    std::array<Vector, B> b;
+    polysche::BatchMatrix<double, N, B> bA;
+    polysche::BatchVector<double, N, B> bb;
+    for (std::size_t l = 0; l < B; ++l)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            double x = static_cast<double>(i) - 2. + 0.1 * static_cast<double>(l);
+            for (std::size_t j = 0; j < N; ++j)
+                A[l][i][j] = std::pow(x, static_cast<double>(j));
+            b[l][i] = static_cast<double>(i * i + l);
+        }
+
+        // Null leading coefficient
+        if (l % 2 == 1)
+            A[l][0][0] = 0.;
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+                bA[i][j][l] = A[l][i][j];
+            bb[i][l] = b[l][i];
+        }
+    }
+
+    auto close = [] (double u, double v) { return std::abs(u - v) <= 1e-10 * (1. + std::abs(v)); };
+
+    // Solve
+    {
+    auto bx = gauss_solve_batch(bA, bb);
+    bool ok = true;
+    for (std::size_t l = 0; l < B; ++l)
+    {
+        auto x = gauss_solve(A[l], b[l]);
+        for (std::size_t i = 0; i < N; ++i)
+            ok = ok and close(bx[i][l], x[i]);
+    }
+    CHECK(ok);
+    }
+
+    // Inverse
+    {
+    auto biA = gauss_inv_batch(bA);
+    bool ok = true;
+    for (std::size_t l = 0; l < B; ++l)
+    {
+        auto iA = gauss_inv(A[l]);
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+                ok = ok and close(biA[i][j][l], iA[i][j]);
+    }
+    CHECK(ok);
+    }
+
+    // A singular lane doesn't affect the others
+    {
+    auto sA = bA;
+    for (std::size_t j = 0; j < N; ++j)
+        sA[1][j][3] = sA[0][j][3];
+
+    auto const result = polysche::gauss_solve_batch_checked(sA, bb);
+    auto const& bx = result.value;
+    bool ok = true;
+    for (std::size_t l = 0; l < B; ++l)
+    {
+        if (l == 3)
+            continue;
+        auto x = gauss_solve(A[l], b[l]);
+        for (std::size_t i = 0; i < N; ++i)
+            ok = ok and close(bx[i][l], x[i]);
+    }
+    CHECK(ok);
+
+    bool mask = true;
+    for (std::size_t l = 0; l < B; ++l)
+        mask = mask and result.is_regular[l] == (l != 3);
+    CHECK(mask);
+
+    auto const inverses = polysche::gauss_inv_batch_checked(sA);
+    CHECK(not inverses.is_regular[3] and inverses.is_regular[0] and inverses.is_regular[B - 1]);
+    }
+
+    // Regular lanes of the unmodified batch
+    {
+    auto const result = polysche::gauss_solve_batch_checked(bA, bb);
+    bool all = true;
+    for (std::size_t l = 0; l < B; ++l)
+        all = all and result.is_regular[l];
+    CHECK(all);
+    }
+
+    return return_code();
+}
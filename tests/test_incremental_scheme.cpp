@@ -0,0 +1,82 @@
+#include <iostream>
+
+#include <polysche/incremental_scheme.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::IncrementalScheme;
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+
+    {
+    std::cout << "Finite differences of order 2:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S_ref = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    constexpr auto S = IncrementalScheme<2>{}.add_eqns(P(-1), P(0), P(1)).solve();
+    std::cout << "S = " << S << std::endl;
+    CHECK(S.coeffs == S_ref.coeffs);
+
+    constexpr auto S_from = IncrementalScheme<2>(PS.add_eqns(P(-1), P(0), P(1))).solve();
+    CHECK(S_from.coeffs == S_ref.coeffs);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Variants sharing a common prefix of equations:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto common = IncrementalScheme<2>{}
+        .add_eqn(P.integrate({-1, 2}, { 1, 2}))
+        .add_eqn(P.integrate({ 1, 2}, { 3, 2}));
+    CHECK(common.is_regular() && common.rank == 2);
+
+    constexpr auto S_neumann = common.add_eqn(P.derivate()(Rational(3, 2))).solve();
+    constexpr auto S_dirichlet = common.add_eqn(P(Rational(3, 2))).solve();
+    std::cout << "S_neumann = " << S_neumann << std::endl;
+    std::cout << "S_dirichlet = " << S_dirichlet << std::endl;
+
+    constexpr auto S_neumann_ref = PS
+        .add_eqn(P.integrate({-1, 2}, { 1, 2}))
+        .add_eqn(P.integrate({ 1, 2}, { 3, 2}))
+        .add_eqn(P.derivate()(Rational(3, 2)))
+        .solve();
+    constexpr auto S_dirichlet_ref = PS
+        .add_eqn(P.integrate({-1, 2}, { 1, 2}))
+        .add_eqn(P.integrate({ 1, 2}, { 3, 2}))
+        .add_eqn(P(Rational(3, 2)))
+        .solve();
+    CHECK(S_neumann.coeffs == S_neumann_ref.coeffs);
+    CHECK(S_dirichlet.coeffs == S_dirichlet_ref.coeffs);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Higher order Hermite spline:" << std::endl;
+    constexpr auto PS = PolynomialScheme<5>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto eqns = std::array{
+        P(0), P(1), P.derivate()(0), P.derivate()(1), P.derivate(2)(0), P.derivate(2)(1)
+    };
+    constexpr auto S = IncrementalScheme<5>{}.add_eqns(eqns).solve();
+    constexpr auto S_ref = PS.add_eqns(eqns).solve();
+    std::cout << "S = " << S << std::endl;
+    CHECK(S.coeffs == S_ref.coeffs);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Linearly dependent equation:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto IS = IncrementalScheme<2>{}.add_eqns(P(0), P(1), P(1));
+    CHECK(not IS.is_regular() && IS.rank == 2);
+    std::cout << std::endl;
+    }
+
+    return return_code();
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <array>
+
+#include <polysche/least_squares_scheme.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::LeastSquaresScheme;
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+    using T = Rational<long long int>;
+
+    {
+    std::cout << "Quadratic fit on 5 points:" << std::endl;
+    constexpr auto LS = LeastSquaresScheme<2, 5>{};
+    constexpr auto P = LS.get_polynomial();
+    constexpr auto S = LS.add_eqns(P(-2), P(-1), P(0), P(1), P(2)).solve();
+    std::cout << S << std::endl;
+    CHECK((S(0) == std::array<T, 5>{T(-3, 35), T(12, 35), T(17, 35), T(12, 35), T(-3, 35)}));
+    CHECK((S.derivate()(0) == std::array<T, 5>{T(-1, 5), T(-1, 10), T(0), T(1, 10), T(1, 5)}));
+
+    // Same equations given as an array
+    constexpr auto SA = LS.add_eqns(std::array{P(-2), P(-1), P(0), P(1), P(2)}).solve();
+    CHECK(SA.coeffs == S.coeffs);
+    }
+
+    {
+    std::cout << "Square system is the interpolation:" << std::endl;
+    constexpr auto LS = LeastSquaresScheme<2, 3>{};
+    constexpr auto P = LS.get_polynomial();
+    constexpr auto S = LS.add_eqns(P(-1), P(0), P(1)).solve();
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto SI = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    CHECK(S.coeffs == SI.coeffs);
+    }
+
+    {
+    std::cout << "Linear fit of cell averages:" << std::endl;
+    constexpr auto LS = LeastSquaresScheme<1, 4>{};
+    constexpr auto P = LS.get_polynomial();
+    constexpr auto S = LS.add_eqns(4, [&P] (std::size_t k) {
+        int i = static_cast<int>(k) - 2;
+        return P.integrate(i, i + 1);
+    }).solve();
+    std::cout << S << std::endl;
+
+    // Averages of an affine function are fitted exactly
+    std::array<T, 4> averages = {T(-5, 2), T(-1, 2), T(3, 2), T(7, 2)}; // u(x) = 2x + 1/2
+    auto c0 = T(0), c1 = T(0);
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        c0 = c0 + S.coeffs[0][k] * averages[k];
+        c1 = c1 + S.coeffs[1][k] * averages[k];
+    }
+    CHECK(c0 == T(1, 2) and c1 == T(2));
+    }
+
+    {
+    std::cout << "Rank deficient system:" << std::endl;
+    constexpr auto LS = LeastSquaresScheme<2, 4>{};
+    constexpr auto P = LS.get_polynomial();
+    constexpr auto LS2 = LS.add_eqns(P(0), P(1), P(0), P(1));
+    CHECK(not LS2.is_regular());
+    CHECK(not LS2.solve_checked());
+    CHECK(LS2.solve_checked().rank == 2);
+    CHECK(LS.add_eqns(P(0), P(1), P(2), P(1)).solve_checked().is_regular);
+    }
+
+    return return_code();
+}
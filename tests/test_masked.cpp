@@ -0,0 +1,96 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+#include <polysche/masked.hpp>
+#include <polysche/stencil.hpp>
+
+#include "utils.hpp"
+
+/// Pseudo-random generator (SplitMix64) so that the test doesn't depend on the library internals
+std::uint64_t next_random(std::uint64_t & state)
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+int main()
+{
+    using polysche::make_stencil;
+    using polysche::apply_stencil;
+
+    constexpr auto D = make_stencil(std::array{1., -2., 1.}, -1);
+
+    constexpr std::size_t n = 1000;
+    std::vector<double> u(n + 2);
+    for (std::size_t i = 0; i < u.size(); ++i)
+        u[i] = std::sin(0.01 * static_cast<double>(i * i));
+
+    std::vector<double> reference(n);
+    apply_stencil(D, u.data() + 1, n, reference.data());
+
+    // Mask made of full words, empty words, runs across words and isolated cells
+    std::vector<std::uint64_t> mask((n + 63) / 64, 0);
+    std::vector<bool> active(n, false);
+    std::uint64_t state = 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        bool a = (i >= 60 and i < 200) or (i >= 300 and i < 320) or (i >= 500 and next_random(state) % 3 == 0);
+        active[i] = a;
+        if (a)
+            mask[i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+    mask.back() |= ~std::uint64_t(0) << (n % 64); // Bits beyond count are ignored
+
+    // Maximal runs
+    {
+    auto intervals = polysche::make_intervals(mask.data(), n);
+    CHECK(intervals.size() > 2);
+    CHECK(intervals[0].first == 60 and intervals[0].last == 200);
+    CHECK(intervals[1].first == 300 and intervals[1].last == 320);
+    bool ok = true;
+    std::size_t covered = 0;
+    for (std::size_t k = 0; k < intervals.size(); ++k)
+    {
+        ok = ok and (k == 0 or intervals[k].first > intervals[k - 1].last) and intervals[k].last <= n;
+        for (std::size_t i = intervals[k].first; i < intervals[k].last; ++i)
+            ok = ok and active[i];
+        covered += intervals[k].size();
+    }
+    std::size_t count = 0;
+    for (bool a : active)
+        count += a ? 1 : 0;
+    CHECK(ok and covered == count);
+    }
+
+    // Masked and interval applications
+    {
+    std::vector<double> out(n, -1.), out_intervals(n, -1.);
+    polysche::apply_stencil_masked(D, u.data() + 1, mask.data(), n, out.data());
+    polysche::apply_stencil_intervals(D, u.data() + 1, polysche::make_intervals(mask.data(), n), out_intervals.data());
+
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i)
+        ok = ok and out[i] == (active[i] ? reference[i] : -1.);
+    CHECK(ok);
+    CHECK(out == out_intervals);
+    }
+
+    // Compress-store
+    {
+    std::vector<double> out(n);
+    auto written = polysche::apply_stencil_compressed(D, u.data() + 1, mask.data(), n, out.data());
+    bool ok = true;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        if (active[i])
+            ok = ok and out[k++] == reference[i];
+    CHECK(ok and written == k);
+    }
+
+    return return_code();
+}
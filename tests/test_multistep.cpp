@@ -0,0 +1,81 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/multistep.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::Rational;
+    using R = Rational<long long int>;
+    using polysche::adams_bashforth;
+    using polysche::adams_moulton;
+    using polysche::bdf;
+
+    // Fixed step coefficients
+    {
+    constexpr auto AB2 = adams_bashforth<2>();
+    constexpr auto AB3 = adams_bashforth<3>();
+    constexpr auto AM2 = adams_moulton<2>();
+    constexpr auto BDF2 = bdf<2>();
+    constexpr auto BDF3 = bdf<3>();
+    std::cout << "AB3 = " << AB3 << ", AM2 = " << AM2 << ", BDF3 = " << BDF3 << std::endl;
+
+    CHECK((AB2 == std::array{R(3, 2), R(-1, 2)}));
+    CHECK((AB3 == std::array{R(23, 12), R(-4, 3), R(5, 12)}));
+    CHECK((AM2 == std::array{R(5, 12), R(2, 3), R(-1, 12)}));
+    CHECK((BDF2 == std::array{R(3, 2), R(-2), R(1, 2)}));
+    CHECK((BDF3 == std::array{R(11, 6), R(-3), R(3, 2), R(-1, 3)}));
+    CHECK((adams_moulton<1>() == std::array{R(1, 2), R(1, 2)}));
+    }
+
+    // Variable step: h_{n-1} = 2 h_n
+    {
+    constexpr auto nodes = polysche::variable_step_nodes(std::array{R(2)}, R(1));
+    CHECK((nodes == std::array{R(0), R(-2)}));
+    constexpr auto AB2 = polysche::adams_coefficients(nodes);
+    CHECK((AB2 == std::array{R(5, 4), R(-1, 4)}));
+
+    auto const nodes3 = polysche::variable_step_nodes(std::array{R(1, 2), R(3, 2)}, R(1));
+    auto const BDF = polysche::bdf_coefficients(std::array{R(1), nodes3[0], nodes3[1], nodes3[2]});
+    R sum = 0;
+    for (auto const& a : BDF)
+        sum = sum + a;
+    CHECK(sum == R(0)); // Exact for constants
+
+    // Floating point nodes (solved at run time)
+    auto const AB2_double = polysche::adams_coefficients(polysche::variable_step_nodes(std::array{2.}, 1.));
+    CHECK(std::abs(AB2_double[0] - 1.25) < 1e-15 and std::abs(AB2_double[1] + 0.25) < 1e-15);
+    }
+
+    // Fused Adams-Bashforth update: y' = f(t) = 3 t^2 (exact for AB3)
+    {
+    std::size_t const n = 100;
+    double const h = 0.25, t = 1.;
+    auto f = [] (double s) { return 3. * s * s; };
+    std::vector<double> y(n), f0(n), f1(n), f2(n), next(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double const c = static_cast<double>(i);
+        y[i] = t * t * t + c;
+        f0[i] = f(t);
+        f1[i] = f(t - h);
+        f2[i] = f(t - 2. * h);
+    }
+
+    double const* y_n = y.data();
+    std::array<double const*, 3> history{f0.data(), f1.data(), f2.data()};
+    polysche::multistep_update(std::array{1}, std::array{y_n}, adams_bashforth<3>(), history, h, n, next.data());
+
+    bool exact = true;
+    for (std::size_t i = 0; i < n; ++i)
+        exact = exact and std::abs(next[i] - ((t + h) * (t + h) * (t + h) + static_cast<double>(i))) < 1e-12;
+    CHECK(exact);
+    }
+
+    return return_code();
+}
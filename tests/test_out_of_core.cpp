@@ -0,0 +1,132 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include <polysche/out_of_core.hpp>
+#include <polysche/stencil.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+/// Path of a file in the temporary directory
+std::string temp_path(std::string const& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+bool write_file(std::string const& path, std::vector<double> const& values)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+    return static_cast<bool>(file);
+}
+
+std::vector<double> read_file(std::string const& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<double> values(static_cast<std::size_t>(file.tellg()) / sizeof(double));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+    return values;
+}
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::make_stencil;
+    using polysche::apply_stencil;
+
+    constexpr auto PS = PolynomialScheme<4>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-2), P(-1), P(0), P(1), P(2)).solve();
+    constexpr auto D = make_stencil(S.derivate()(0), -2);
+
+    // 1D file processed by small tiles
+    {
+    constexpr std::size_t n = 10000;
+    std::vector<double> u(n);
+    for (std::size_t i = 0; i < n; ++i)
+        u[i] = std::sin(1e-3 * static_cast<double>(i * i % 7919));
+    auto const in_path = temp_path("test_out_of_core_1d.bin");
+    auto const out_path = temp_path("test_out_of_core_1d_out.bin");
+    CHECK(write_file(in_path, u));
+
+    CHECK(polysche::apply_stencil_file(D, in_path, out_path, 777));
+    auto v = read_file(out_path);
+
+    std::vector<double> expected(n - 4);
+    apply_stencil(D, u.data() + 2, n - 4, expected.data());
+    CHECK(v == expected);
+
+    CHECK(not polysche::apply_stencil_file(D, temp_path("test_out_of_core_missing.bin"), out_path));
+
+    // Trailing partial value
+    {
+        std::ofstream file(in_path, std::ios::binary | std::ios::app);
+        file.put('\0');
+    }
+    CHECK(not polysche::apply_stencil_file(D, in_path, out_path));
+
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(out_path);
+    }
+
+    // 2D file along both axes
+    {
+    constexpr std::size_t nx = 300;
+    constexpr std::size_t ny = 70;
+    std::vector<double> u(nx * ny);
+    for (std::size_t y = 0; y < ny; ++y)
+        for (std::size_t x = 0; x < nx; ++x)
+            u[y * nx + x] = std::cos(0.01 * static_cast<double>(x)) * static_cast<double>(y * y);
+    auto const in_path = temp_path("test_out_of_core_2d.bin");
+    auto const x_path = temp_path("test_out_of_core_2d_x.bin");
+    auto const y_path = temp_path("test_out_of_core_2d_y.bin");
+    CHECK(write_file(in_path, u));
+
+    CHECK(polysche::apply_stencil_file_2d(D, in_path, x_path, nx, 0, 9));
+    CHECK(polysche::apply_stencil_file_2d(D, in_path, y_path, nx, 1, 9));
+    auto vx = read_file(x_path);
+    auto vy = read_file(y_path);
+    CHECK(vx.size() == (nx - 4) * ny);
+    CHECK(vy.size() == nx * (ny - 4));
+
+    bool ok = vx.size() == (nx - 4) * ny and vy.size() == nx * (ny - 4);
+    for (std::size_t y = 0; y < ny and ok; ++y)
+        for (std::size_t x = 0; x < nx; ++x)
+        {
+            if (x + 4 < nx)
+                ok = ok and vx[y * (nx - 4) + x] == D(u.data() + y * nx + x + 2);
+            if (y + 4 < ny)
+            {
+                double d = 0.;
+                for (std::size_t j = 0; j < 5; ++j)
+                    d += D.weights[j] * u[(y + j) * nx + x];
+                ok = ok and std::abs(vy[y * nx + x] - d) < 1e-12 * (1. + std::abs(d));
+                ok = ok and std::abs(vy[y * nx + x] - 2. * static_cast<double>(y + 2) * std::cos(0.01 * static_cast<double>(x))) < 1e-9;
+            }
+        }
+    CHECK(ok);
+
+    // Invalid axis, trailing partial row and input smaller than one row (with an existing output)
+    CHECK(not polysche::apply_stencil_file_2d(D, in_path, x_path, nx, 2));
+    CHECK(not polysche::apply_stencil_file_2d(D, in_path, x_path, nx + 1, 0));
+    CHECK(write_file(in_path, std::vector<double>(nx - 1, 1.)));
+    CHECK(not polysche::apply_stencil_file_2d(D, in_path, x_path, nx, 0));
+    CHECK(read_file(x_path).size() == (nx - 4) * ny);
+
+    // Empty mapping in write mode truncates the file
+    CHECK(not polysche::MappedFile(x_path, polysche::MappedFile::Mode::write, 0).is_valid());
+    CHECK(read_file(x_path).empty());
+
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(x_path);
+    std::filesystem::remove(y_path);
+    }
+
+    return return_code();
+}
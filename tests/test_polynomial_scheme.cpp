@@ -6,14 +6,15 @@
 #include "utils.hpp"
 
 template <std::size_t Order>
-constexpr auto make_finite_volume() noexcept
+constexpr auto make_finite_volume_generated() noexcept
 {
     using polysche::PolynomialScheme;
-    auto PS = PolynomialScheme<Order>{};
-    auto P = PS.get_polynomial();
-    for (int i = - static_cast<int>(Order) / 2; i <= static_cast<int>(Order) / 2; ++i)
-        PS = PS.add_eqn(P.integrate({2 * i - 1, 2}, {2 * i + 1, 2}));
-    return PS.solve();
+    constexpr auto PS = PolynomialScheme<Order>{};
+    constexpr auto P = PS.get_polynomial();
+    return PS.add_eqns(Order + 1, [&P] (std::size_t k) {
+        int i = static_cast<int>(k) - static_cast<int>(Order) / 2;
+        return P.integrate({2 * i - 1, 2}, {2 * i + 1, 2});
+    }).solve();
 }
 
 int main()
@@ -37,6 +38,46 @@ int main()
     std::cout << std::endl;
     }
 
+    {
+    std::cout << "Finite differences of order 2 using add_eqns:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S1 = PS.add_eqn(P(-1)).add_eqn(P(0)).add_eqn(P(1)).solve();
+    constexpr auto S2 = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    constexpr auto S3 = PS.add_eqns(std::array{P(-1), P(0), P(1)}).solve();
+    CHECK(S1.coeffs == S2.coeffs);
+    CHECK(S1.coeffs == S3.coeffs);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Neumann variant from a solved scheme:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    CHECK(polysche::can_replace_eqn(S, 0, P.derivate()(0)));
+    CHECK(not polysche::can_replace_eqn(S, 0, P(1)));
+    constexpr auto S_neumann = polysche::replace_eqn(S, 0, P.derivate()(0));
+    constexpr auto S_neumann_ref = PS.add_eqns(P(-1), P(0), P(1)).replace_eqn(0, P.derivate()(0)).solve();
+    std::cout << "S_neumann = " << S_neumann << std::endl;
+    CHECK(S_neumann.coeffs == S_neumann_ref.coeffs);
+    std::cout << std::endl;
+    }
+
+    {
+    std::cout << "Singular scheme:" << std::endl;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto PS_singular = PS.add_eqns(P.derivate()(0), P.derivate()(1), P.derivate(2)(0));
+    CHECK(not PS_singular.is_regular());
+    CHECK(not PS_singular.solve_checked());
+    constexpr auto PS_regular = PS.add_eqns(P.integrate(0, 1), P(0), P(1));
+    CHECK(PS_regular.is_regular());
+    constexpr auto S = PS_regular.solve_checked();
+    CHECK(S and S.rank == 3 and S.value.coeffs == PS_regular.solve().coeffs);
+    std::cout << std::endl;
+    }
+
     {
     std::cout << "Finite differences of order 2 with Neumann boundary condition:" << std::endl;
     constexpr auto PS = PolynomialScheme<2>{}; // Order 2
@@ -138,7 +179,7 @@ int main()
 
     {
     std::cout << "Finite volume of order 6:" << std::endl;
-    constexpr auto S = make_finite_volume<6>();
+    constexpr auto S = schemes::make_finite_volume<6>();
     std::cout << "int_{-1/2}^0 S = " << S.integrate({-1, 2}, 0) << std::endl;
     std::cout << "int_0^{1/2} S = " << S.integrate(0, {1, 2}) << std::endl;
     std::cout << std::endl;
@@ -146,16 +187,18 @@ int main()
 
     {
     std::cout << "Finite volume of order 8:" << std::endl;
-    constexpr auto S = make_finite_volume<8>();
+    constexpr auto S = schemes::make_finite_volume<8>();
     std::cout << "int_{-1/2}^0 S(x) = " << S.integrate({-1, 2}, 0) << std::endl;
     std::cout << "int_0^{1/2}  S(x) = " << S.integrate(0, {1, 2})  << std::endl;
+    constexpr auto SG = make_finite_volume_generated<8>();
+    CHECK(S.coeffs == SG.coeffs);
     std::cout << std::endl;
     }
 
 #if 0 // Reaches maximum step limit for constexpr evaluation in LLVM
     {
     std::cout << "Finite volume of order 10:" << std::endl;
-    constexpr auto S = make_finite_volume<10>();
+    constexpr auto S = schemes::make_finite_volume<10>();
     std::cout << "int_{-1/2}^0 S = " << S.integrate({-1, 2}, 0) << std::endl;
     std::cout << "int_0^{1/2} S = " << S.integrate(0, {1, 2}) << std::endl;
     std::cout << std::endl;
@@ -215,6 +258,6 @@ int main()
     std::cout << std::endl;
     }
 
-    return 0;
+    return return_code();
 }
 
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <polysche/remap.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::make_remap;
+    using polysche::make_remap_2d;
+    using polysche::apply_remap;
+
+    // Non-matching non-uniform grids of [0, 1]
+    double const two_pi = 8. * std::atan(1.);
+    auto grid = [two_pi] (std::size_t n, double a) {
+        std::vector<double> edges(n + 1);
+        for (std::size_t i = 0; i <= n; ++i)
+        {
+            double const s = static_cast<double>(i) / static_cast<double>(n);
+            edges[i] = s + a * std::sin(two_pi * s) / two_pi;
+        }
+        return edges;
+    };
+    auto const source = grid(40, 0.5);
+    auto const target = grid(27, -0.3);
+
+    // Averages of a quadratic function (primitive F)
+    auto F = [] (double x) { return x * x * x - 0.5 * x * x + 2. * x; };
+    auto averages = [&F] (std::vector<double> const& edges) {
+        std::vector<double> u(edges.size() - 1);
+        for (std::size_t i = 0; i < u.size(); ++i)
+            u[i] = (F(edges[i + 1]) - F(edges[i])) / (edges[i + 1] - edges[i]);
+        return u;
+    };
+
+    auto const R = make_remap<2>(source, target, 3);
+    CHECK(R.rows == 27 and R.cols == 40);
+
+    auto const u = averages(source);
+    auto const expected = averages(target);
+    std::vector<double> v(R.rows);
+    apply_remap(R, u.data(), v.data(), 2);
+
+    double error = 0., source_mass = 0., target_mass = 0.;
+    for (std::size_t t = 0; t < v.size(); ++t)
+    {
+        error = std::max(error, std::abs(v[t] - expected[t]));
+        target_mass += v[t] * (target[t + 1] - target[t]);
+    }
+    for (std::size_t i = 0; i < u.size(); ++i)
+        source_mass += u[i] * (source[i + 1] - source[i]);
+    std::cout << "1D remap error = " << error << ", mass difference = " << target_mass - source_mass << std::endl;
+    CHECK(error < 1e-10);
+    CHECK(std::abs(target_mass - source_mass) < 1e-12);
+
+    // Same as the sequential CSR product (up to rounding, the compiler may contract the operations differently)
+    std::vector<double> w(R.rows);
+    R.multiply(u.data(), w.data());
+    bool same = true;
+    for (std::size_t t = 0; t < w.size(); ++t)
+        same = same and std::abs(w[t] - v[t]) <= 1e-13 * (1. + std::abs(v[t]));
+    CHECK(same);
+
+    // 2D rectilinear grids: f(x, y) = x^2 y + y^2
+    {
+    auto const sx = grid(20, 0.4), sy = grid(15, -0.2), tx = grid(13, 0.1), ty = grid(17, 0.3);
+    auto const R2 = make_remap_2d<2>(sx, sy, tx, ty);
+    CHECK(R2.rows == 13 * 17 and R2.cols == 20 * 15);
+
+    auto average2d = [] (std::vector<double> const& ex, std::vector<double> const& ey) {
+        std::vector<double> a((ex.size() - 1) * (ey.size() - 1));
+        for (std::size_t j = 0; j + 1 < ey.size(); ++j)
+            for (std::size_t i = 0; i + 1 < ex.size(); ++i)
+            {
+                double const x0 = ex[i], x1 = ex[i + 1], y0 = ey[j], y1 = ey[j + 1];
+                double const int_x2 = (x1 * x1 * x1 - x0 * x0 * x0) / 3., int_y = (y1 * y1 - y0 * y0) / 2., int_y2 = (y1 * y1 * y1 - y0 * y0 * y0) / 3.;
+                a[j * (ex.size() - 1) + i] = (int_x2 * int_y + (x1 - x0) * int_y2) / ((x1 - x0) * (y1 - y0));
+            }
+        return a;
+    };
+
+    auto const u2 = average2d(sx, sy);
+    auto const expected2 = average2d(tx, ty);
+    std::vector<double> v2(R2.rows);
+    apply_remap(R2, u2.data(), v2.data());
+
+    double error2 = 0.;
+    for (std::size_t t = 0; t < v2.size(); ++t)
+        error2 = std::max(error2, std::abs(v2[t] - expected2[t]));
+    std::cout << "2D remap error = " << error2 << std::endl;
+    CHECK(error2 < 1e-10);
+    }
+
+    return return_code();
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/resampling.hpp>
+#include <polysche/ring_buffer.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::make_polyphase_bank;
+    using polysche::StreamingResampler;
+
+    // Ring buffer
+    {
+    polysche::RingBuffer<int, 3> history;
+    for (int i = 1; i <= 5; ++i)
+        history.push(i);
+    auto window = history.window();
+    CHECK(window[0] == 3 and window[1] == 4 and window[2] == 5);
+    CHECK(history.back() == 5 and history.back(2) == 3);
+    }
+
+    // Polyphase bank
+    {
+    constexpr auto bank = make_polyphase_bank<3, 4>();
+    static_assert(bank.first == -1);
+    std::cout << "bank = " << bank.phases << std::endl;
+    CHECK((bank.phases[0] == std::array<double, 4>{0., 1., 0., 0.}));
+    CHECK((bank.phases[2] == std::array<double, 4>{-1. / 16, 9. / 16, 9. / 16, -1. / 16}));
+    }
+
+    // Resampling of a cubic polynomial by 3/2, by chunks of various sizes
+    {
+    constexpr std::size_t L = 3;
+    constexpr std::size_t M = 2;
+    StreamingResampler resampler(make_polyphase_bank<3, L>(), M);
+
+    auto u = [] (double x) { return 0.01 * x * x * x - x * x + 2.; };
+    constexpr std::size_t n = 300;
+    std::vector<double> input(n);
+    for (std::size_t i = 0; i < n; ++i)
+        input[i] = u(static_cast<double>(i));
+
+    std::vector<double> output;
+    std::vector<double> buffer(resampler.max_output(17));
+    std::size_t i = 0;
+    for (std::size_t chunk = 1; i < n; chunk = chunk % 17 + 1)
+    {
+        std::size_t count = std::min(chunk, n - i);
+        auto written = resampler.process(input.data() + i, count, buffer.data());
+        CHECK(written <= resampler.max_output(count));
+        output.insert(output.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(written));
+        i += count;
+    }
+
+    // The output sample k at position k * M / L needs the input samples up to floor(k * M / L) + 2
+    std::size_t expected_count = 0;
+    while ((expected_count * M) / L + 2 < n)
+        ++expected_count;
+    CHECK(output.size() == expected_count);
+
+    // Exact reproduction once the stencils don't involve samples before the stream beginning
+    bool ok = true;
+    for (std::size_t k = 2; k < output.size(); ++k)
+    {
+        double x = static_cast<double>(k * M) / static_cast<double>(L);
+        ok = ok and std::abs(output[k] - u(x)) < 1e-9 * (1. + std::abs(u(x)));
+    }
+    CHECK(ok);
+
+    // Restarting gives the same output
+    resampler.reset();
+    std::vector<double> all(resampler.max_output(n));
+    auto written = resampler.process(input.data(), n, all.data());
+    all.resize(written);
+    CHECK(all == output);
+    }
+
+    // Decimation by 1/3
+    {
+    StreamingResampler resampler(make_polyphase_bank<1, 1>(0), 3);
+    std::array<double, 10> input = {0., 1., 2., 3., 4., 5., 6., 7., 8., 9.};
+    std::array<double, 5> output{};
+    auto written = resampler.process(input.data(), input.size(), output.data());
+    CHECK(written == 3);
+    CHECK(output[0] == 0. and output[1] == 3. and output[2] == 6.);
+    }
+
+    return return_code();
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/savitzky_golay.hpp>
+#include <polysche/stencil.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::savitzky_golay;
+    using polysche::make_savitzky_golay;
+    using polysche::apply_stencil;
+    using polysche::apply_stencils;
+    using polysche::Rational;
+    using T = Rational<long long int>;
+
+    // Classical coefficients (quartic fit on 9 points)
+    {
+    constexpr auto S = savitzky_golay<4, 9>();
+    std::cout << "SG(4, 9) = " << S(0) << std::endl;
+    CHECK((S(0) == std::array<T, 9>{T(15, 429), T(-55, 429), T(30, 429), T(135, 429), T(179, 429),
+                                     T(135, 429), T(30, 429), T(-55, 429), T(15, 429)}));
+    }
+
+    // Centered bank and edge variants
+    constexpr auto SG = make_savitzky_golay<3, 7, 2>();
+    constexpr auto SG_left = make_savitzky_golay<3, 7, 2>(0);
+    constexpr auto SG_right = make_savitzky_golay<3, 7, 2>(-6);
+    static_assert(SG[0].first == -3 and SG_left[1].first == 0 and SG_right[2].last() == 0);
+
+    constexpr std::size_t n = 200;
+    auto u = [] (double x) { return 1e-4 * x * x * x - 0.02 * x * x + x - 3.; };
+    auto du = [] (double x) { return 3e-4 * x * x - 0.04 * x + 1.; };
+    auto d2u = [] (double x) { return 6e-4 * x - 0.04; };
+
+    std::vector<double> field(n + 6);
+    for (std::size_t i = 0; i < field.size(); ++i)
+        field[i] = u(static_cast<double>(i) - 3.);
+
+    // Fused kernel: smoothed value and derivatives in one pass (exact for a cubic polynomial)
+    std::vector<double> v(n), dv(n), d2v(n);
+    apply_stencils(SG, field.data() + 3, n, {v.data(), dv.data(), d2v.data()});
+
+    std::vector<double> dv_ref(n);
+    apply_stencil(SG[1], field.data() + 3, n, dv_ref.data());
+
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double x = static_cast<double>(i);
+        ok = ok and std::abs(v[i] - u(x)) < 1e-10;
+        ok = ok and std::abs(dv[i] - du(x)) < 1e-10;
+        ok = ok and std::abs(d2v[i] - d2u(x)) < 1e-10;
+        ok = ok and std::abs(dv[i] - dv_ref[i]) < 1e-14;
+    }
+    CHECK(ok);
+
+    // Boundaries
+    double const* left = field.data() + 3;
+    double const* right = field.data() + 3 + n - 1;
+    CHECK(std::abs(SG_left[0](left) - u(0.)) < 1e-10);
+    CHECK(std::abs(SG_left[1](left) - du(0.)) < 1e-10);
+    CHECK(std::abs(SG_right[0](right) - u(n - 1.)) < 1e-10);
+    CHECK(std::abs(SG_right[2](right) - d2u(n - 1.)) < 1e-10);
+
+    // Noise reduction of the smoothing stencil (sum of squared weights < 1)
+    double gain = 0.;
+    for (auto w : SG[0].weights)
+        gain += w * w;
+    CHECK(gain < 0.5);
+
+    return return_code();
+}
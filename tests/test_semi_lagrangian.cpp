@@ -0,0 +1,107 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/semi_lagrangian.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+    using polysche::make_semi_lagrangian;
+
+    // Weights compared to the solved scheme
+    {
+    constexpr auto SL = make_semi_lagrangian<3>();
+    static_assert(SL.first == -1);
+    constexpr auto PS = PolynomialScheme<3>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-1), P(0), P(1), P(2)).solve();
+
+    auto w = SL.weights(0.25);
+    auto ws = S(Rational<long long int>(1, 4));
+    std::cout << "w(1/4) = " << w << std::endl;
+    bool ok = true;
+    for (std::size_t j = 0; j < 4; ++j)
+        ok = ok and std::abs(w[j] - static_cast<double>(ws[j])) < 1e-15;
+    CHECK(ok);
+
+    // Exact kernel
+    constexpr auto SLR = make_semi_lagrangian<3, Rational<long long int>>();
+    CHECK(SLR.weights(Rational<long long int>(1, 4)) == ws);
+    }
+
+    // Advection of a cubic polynomial (reproduced exactly)
+    {
+    constexpr auto SL = make_semi_lagrangian<3>();
+    constexpr std::size_t n = 200;
+    constexpr std::ptrdiff_t ghosts = 8;
+
+    auto u = [] (double x) { return x * x * x - 2. * x + 1.; };
+    std::vector<double> field(n + 2 * ghosts);
+    for (std::size_t i = 0; i < field.size(); ++i)
+        field[i] = u(static_cast<double>(i) - static_cast<double>(ghosts));
+
+    std::vector<double> displacements(n);
+    for (std::size_t k = 0; k < n; ++k)
+        displacements[k] = 3. * std::sin(0.37 * static_cast<double>(k));
+
+    std::vector<double> result(n);
+    SL.advect(field.data() + ghosts, displacements.data(), n, result.data());
+
+    bool ok = true;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        double expected = u(static_cast<double>(k) + displacements[k]);
+        ok = ok and std::abs(result[k] - expected) < 1e-9 * (1. + std::abs(expected));
+    }
+    CHECK(ok);
+
+    // Same points given by cells and offsets
+    std::vector<std::ptrdiff_t> cells(n);
+    std::vector<double> offsets(n);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        double d = std::floor(displacements[k]);
+        cells[k] = static_cast<std::ptrdiff_t>(k) + static_cast<std::ptrdiff_t>(d);
+        offsets[k] = displacements[k] - d;
+    }
+
+    std::vector<double> result2(n);
+    SL.interpolate(field.data() + ghosts, cells.data(), offsets.data(), n, result2.data());
+    bool same = true;
+    for (std::size_t k = 0; k < n; ++k)
+        same = same and std::abs(result2[k] - result[k]) <= 1e-13 * (1. + std::abs(result[k]));
+    CHECK(same);
+    }
+
+    // Kernel from a finite volume reconstruction (cell averages as taps)
+    {
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P.integrate(-1, 0), P.integrate(0, 1), P.integrate(1, 2)).solve();
+    constexpr polysche::SemiLagrangianKernel<double, 2, 3> SL(S, -1);
+
+    // Averages of u(x) = x^2 on [i, i+1]
+    std::vector<double> averages(16);
+    for (std::size_t i = 0; i < averages.size(); ++i)
+    {
+        double a = static_cast<double>(i);
+        averages[i] = ((a + 1.) * (a + 1.) * (a + 1.) - a * a * a) / 3.;
+    }
+
+    std::array<std::ptrdiff_t, 2> cells = {3, 7};
+    std::array<double, 2> offsets = {0.5, 0.125};
+    std::array<double, 2> result;
+    SL.interpolate(averages.data(), cells.data(), offsets.data(), 2, result.data());
+    CHECK(std::abs(result[0] - 3.5 * 3.5) < 1e-12);
+    CHECK(std::abs(result[1] - 7.125 * 7.125) < 1e-12);
+    }
+
+    return return_code();
+}
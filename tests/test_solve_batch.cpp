@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <array>
+
+#include <polysche/solve_batch.hpp>
+#include <polysche/parallel.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::Rational;
+    using polysche::solve_batch;
+
+    // Parallel loop
+    {
+    std::vector<std::size_t> values(1000, 0);
+    polysche::parallel_for(values.size(), [&values] (std::size_t i) { values[i] = i * i; }, 4, 7);
+    bool ok = true;
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ok = ok and values[i] == i * i;
+    CHECK(ok);
+    }
+
+    // Finite volume schemes on a non-uniform grid (one per cell)
+    {
+    std::cout << "Non-uniform finite volumes:" << std::endl;
+    constexpr std::size_t n = 200;
+    std::vector<double> x(n + 1);
+    for (std::size_t i = 0; i <= n; ++i)
+        x[i] = static_cast<double>(i) + 0.25 * static_cast<double>(i % 3);
+
+    std::vector<PolynomialScheme<2, double>> schemes;
+    for (std::size_t i = 1; i + 1 < n; ++i)
+    {
+        double center = 0.5 * (x[i] + x[i + 1]);
+        auto PS = PolynomialScheme<2, double>{};
+        auto P = PS.get_polynomial();
+        for (std::size_t k = i - 1; k <= i + 1; ++k)
+        {
+            auto eqn = P.integrate(x[k] - center, x[k + 1] - center);
+            for (auto & c : eqn)
+                c = c / (x[k + 1] - x[k]);
+            PS.push_eqn(eqn);
+        }
+        schemes.push_back(PS);
+    }
+
+    auto center_value = [] (auto const& S) { return S(0.); };
+    std::vector<std::array<double, 3>> stencils(schemes.size());
+    std::vector<std::array<double, 3>> stencils_seq(schemes.size());
+    solve_batch(schemes.begin(), schemes.end(), stencils.begin(), center_value, 8);
+    solve_batch(schemes.begin(), schemes.end(), stencils_seq.begin(), center_value, 1);
+    CHECK(stencils == stencils_seq);
+
+    bool consistent = true;
+    for (auto const& s : stencils)
+        consistent = consistent and std::abs(s[0] + s[1] + s[2] - 1.) < 1e-12;
+    CHECK(consistent);
+
+    std::vector<polysche::Polynomial<double, 2, 3>> polynomials(schemes.size());
+    solve_batch(schemes.begin(), schemes.end(), polynomials.begin());
+    CHECK(polynomials[42].coeffs == schemes[42].solve().coeffs);
+    }
+
+    return return_code();
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/stencil.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::make_stencil;
+    using polysche::apply_stencil;
+
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    constexpr auto D = make_stencil(S.derivate()(0), -1);
+    static_assert(D.first == -1 and D.last() == 1);
+    CHECK((D.weights == std::array<double, 3>{-0.5, 0., 0.5}));
+
+    // Derivative of a quadratic polynomial (exact)
+    constexpr std::size_t n = 100;
+    std::vector<double> u(n + 2);
+    for (std::size_t i = 0; i < u.size(); ++i)
+    {
+        double x = static_cast<double>(i) - 1.;
+        u[i] = 3. * x * x - x + 2.;
+    }
+
+    std::vector<double> du(n);
+    apply_stencil(D, u.data() + 1, n, du.data());
+
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ok = ok and du[i] == D(u.data() + 1 + i);
+        ok = ok and std::abs(du[i] - (6. * static_cast<double>(i) - 1.)) < 1e-12;
+    }
+    CHECK(ok);
+
+    // Multi-component field (array of structs of 5 values per cell)
+    {
+    constexpr std::size_t C = 5;
+    constexpr std::size_t m = 150;
+    std::vector<double> aos((m + 2) * C);
+    std::array<std::vector<double>, C> soa;
+    for (std::size_t c = 0; c < C; ++c)
+        soa[c].resize(m + 2);
+    for (std::size_t i = 0; i < m + 2; ++i)
+        for (std::size_t c = 0; c < C; ++c)
+        {
+            double v = std::sin(0.1 * static_cast<double>(i) + static_cast<double>(c));
+            aos[i * C + c] = v;
+            soa[c][i] = v;
+        }
+
+    std::vector<double> daos(m * C);
+    polysche::apply_stencil_components<C>(D, aos.data() + C, m, daos.data());
+
+    constexpr auto S0 = make_stencil(S(0), -1);
+    std::vector<double> v0(m * C), v1(m * C);
+    polysche::apply_stencils_components<C>(std::array{S0, D}, aos.data() + C, m, {v0.data(), v1.data()});
+
+    bool same = true;
+    for (std::size_t c = 0; c < C; ++c)
+    {
+        std::vector<double> dsoa(m);
+        apply_stencil(D, soa[c].data() + 1, m, dsoa.data());
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            same = same and std::abs(daos[i * C + c] - dsoa[i]) < 1e-15;
+            same = same and std::abs(v1[i * C + c] - dsoa[i]) < 1e-15;
+            same = same and v0[i * C + c] == soa[c][i + 1];
+        }
+    }
+    CHECK(same);
+    }
+
+    return return_code();
+}
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <polysche/stencil_io.hpp>
+#include <polysche/stencil_table.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+/// Path of a file in the temporary directory
+std::string temp_path(std::string const& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// Overwrites a field of the header of a stencil file
+void write_field(std::string const& path, std::size_t offset, std::uint64_t value)
+{
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::MappedStencilTable;
+    using polysche::make_compact_stencil_table;
+
+    constexpr auto PS = PolynomialScheme<4>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(
+        P.integrate({-5, 2}, {-3, 2}),
+        P.integrate({-3, 2}, {-1, 2}),
+        P.integrate({-1, 2}, { 1, 2}),
+        P.integrate({ 1, 2}, { 3, 2}),
+        P.integrate({ 3, 2}, { 5, 2})
+    ).solve();
+
+    // Stencil table
+    {
+    std::cout << "Stencil table:" << std::endl;
+    constexpr auto left = S.integrate({-1, 2}, 0);
+    constexpr auto right = S.integrate(0, {1, 2});
+    constexpr auto table = make_compact_stencil_table<std::int32_t, 2>(std::array{left, right, right, left});
+    std::vector<double> weights;
+    table.decode(weights);
+    auto stencils = table.view(weights);
+    auto const path = temp_path("test_stencil_io_table.bin");
+
+    CHECK(polysche::save_stencil_table(path, stencils));
+
+    MappedStencilTable mapped(path);
+    CHECK(mapped.is_valid());
+    auto mapped_stencils = mapped.view();
+    CHECK(mapped_stencils.size() == 4 and mapped_stencils.width == 5);
+    CHECK(mapped.header().distinct == 2);
+
+    bool same = true;
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 5; ++j)
+            same = same and mapped_stencils[i][j] == stencils[i][j];
+    CHECK(same);
+
+    // Moving the mapping
+    MappedStencilTable moved = std::move(mapped);
+    CHECK(moved.is_valid() and not mapped.is_valid());
+    CHECK(moved.view()[3][2] == stencils[3][2]);
+
+    // Corrupting the file
+    {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-1, std::ios::end);
+    file.put('\x42');
+    }
+    CHECK(not MappedStencilTable(path).is_valid());
+    CHECK(MappedStencilTable(path, false).is_valid());
+    CHECK(not MappedStencilTable(temp_path("missing_file.bin")).is_valid());
+
+    // Index pointing to a missing stencil, detected even without checksum verification
+    CHECK(polysche::save_stencil_table(path, stencils));
+    {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(polysche::StencilFileHeader));
+    std::uint32_t const index = 2;
+    file.write(reinterpret_cast<char const*>(&index), sizeof(index));
+    }
+    CHECK(not MappedStencilTable(path, false).is_valid());
+
+    // Sizes whose product wraps around to the actual size (distinct * width * sizeof(double) = 5 * 2^64 + 80)
+    CHECK(polysche::save_stencil_table(path, stencils));
+    write_field(path, offsetof(polysche::StencilFileHeader, distinct), (std::uint64_t(1) << 61) + 2);
+    CHECK(not MappedStencilTable(path, false).is_valid());
+    write_field(path, offsetof(polysche::StencilFileHeader, distinct), std::uint64_t(1) << 62);
+    CHECK(not MappedStencilTable(path, false).is_valid());
+    write_field(path, offsetof(polysche::StencilFileHeader, distinct), 2);
+    write_field(path, offsetof(polysche::StencilFileHeader, count), std::uint64_t(1) << 62);
+    CHECK(not MappedStencilTable(path, false).is_valid());
+    }
+
+    // Solved scheme
+    {
+    std::cout << "Solved scheme:" << std::endl;
+    auto const path = temp_path("test_stencil_io_scheme.bin");
+    auto const table_path = temp_path("test_stencil_io_table.bin");
+    CHECK(polysche::save_scheme(path, S));
+
+    std::decay_t<decltype(S)> S_loaded;
+    CHECK(polysche::load_scheme(path, S_loaded));
+    CHECK(S_loaded.coeffs == S.coeffs);
+
+    polysche::Polynomial<polysche::Rational<long long int>, 2, 3> S_wrong;
+    CHECK(not polysche::load_scheme(path, S_wrong));
+    CHECK(not polysche::load_scheme(table_path, S_loaded));
+
+    // Narrower integer type: loaded if every value fits, S untouched otherwise
+    polysche::Polynomial<polysche::Rational<int>, 4, 5> S_int;
+    CHECK(polysche::load_scheme(path, S_int));
+    CHECK(S_int.coeffs[1][0].p == S.coeffs[1][0].p and S_int.coeffs[1][0].q == S.coeffs[1][0].q);
+
+    auto S_big = S;
+    S_big.coeffs[4][4] = polysche::Rational<long long int>(1ll << 40, 3);
+    CHECK(polysche::save_scheme(path, S_big));
+    auto const S_int_before = S_int.coeffs;
+    CHECK(not polysche::load_scheme(path, S_int));
+    CHECK(S_int.coeffs == S_int_before);
+    CHECK(polysche::load_scheme(path, S_loaded));
+    CHECK(S_loaded.coeffs == S_big.coeffs);
+
+    // Zero denominator in the last entry (with a consistent checksum), S untouched
+    std::vector<std::int64_t> values;
+    for (auto const& row : S.coeffs)
+        for (auto const& c : row)
+        {
+            values.push_back(static_cast<std::int64_t>(c.p));
+            values.push_back(static_cast<std::int64_t>(c.q));
+        }
+    values.back() = 0;
+    CHECK(polysche::save_scheme(path, S));
+    {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(polysche::StencilFileHeader));
+    file.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(std::int64_t)));
+    }
+    write_field(path, offsetof(polysche::StencilFileHeader, checksum), polysche::detail::fnv1a(values.data(), values.size() * sizeof(std::int64_t)));
+    CHECK(not polysche::load_scheme(path, S_loaded));
+    CHECK(S_loaded.coeffs == S_big.coeffs);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(table_path);
+    }
+
+    return return_code();
+}
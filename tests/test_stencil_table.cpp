@@ -0,0 +1,71 @@
+#include <iostream>
+#include <cstdint>
+#include <vector>
+
+#include <polysche/stencil_table.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::Rational;
+    using polysche::make_compact_stencil_table;
+
+    {
+    std::cout << "Prediction stencils of order 4:" << std::endl;
+    constexpr auto S = schemes::make_finite_volume<4>();
+    constexpr auto left = S.integrate({-1, 2}, 0);
+    constexpr auto right = S.integrate(0, {1, 2});
+    constexpr auto stencils_table = std::array{left, right, left, right, left};
+    constexpr auto distinct = polysche::count_distinct_stencils(stencils_table);
+    constexpr auto table = make_compact_stencil_table<std::int16_t, distinct>(stencils_table);
+    CHECK(table.is_valid);
+    CHECK(distinct == 2 and table.distinct == 2);
+    CHECK(table.numerators.size() == 2 and table.denominators.size() == 2 and table.index.size() == 5);
+
+    // Storage too small for the distinct stencils
+    CHECK((not make_compact_stencil_table<std::int16_t, 1>(stencils_table).is_valid));
+    CHECK(table.index[2] == 0 and table.index[3] == 1 and table.index[4] == 0);
+    std::cout << "left numerators = " << table.numerators[0] << " / " << table.denominators[0] << std::endl;
+
+    std::vector<double> weights;
+    table.decode(weights);
+    CHECK(weights.size() == 2 * 5);
+
+    auto stencils = table.view(weights);
+    CHECK(stencils.size() == 5);
+    bool exact = true;
+    for (std::size_t i = 0; i < stencils.size(); ++i)
+        for (std::size_t j = 0; j < 5; ++j)
+        {
+            auto const& ref = (i % 2 == 0) ? left : right;
+            exact = exact and stencils[i][j] == static_cast<double>(ref[j]);
+        }
+    CHECK(exact);
+
+    constexpr auto right_decoded = table.decode(3);
+    CHECK(right_decoded[2] == 0.5);
+    }
+
+    {
+    std::cout << "Overflow of the numerators:" << std::endl;
+    constexpr auto S = schemes::make_finite_volume<8>();
+    constexpr auto left = S.integrate({-1, 2}, 0); // Denominator 65536
+    constexpr auto right = S.integrate(0, {1, 2});
+    constexpr auto table16 = make_compact_stencil_table<std::int16_t, 2>(std::array{left, right});
+    constexpr auto table32 = make_compact_stencil_table<std::int32_t, 2>(std::array{left, right});
+    CHECK(not table16.is_valid);
+    CHECK(table32.is_valid and table32.denominators[0] == 65536);
+
+    // Common denominator overflowing the Rational type (product of two primes close to 2^32)
+    using R = Rational<long long int>;
+    constexpr std::array<std::array<R, 2>, 1> coprime{{{R(1, 4294967291ll), R(1, 4294967279ll)}}};
+    CHECK((not make_compact_stencil_table<std::int64_t, 1>(coprime).is_valid));
+    constexpr std::array<std::array<R, 2>, 1> common{{{R(1, 4294967291ll), R(3, 4294967291ll)}}};
+    CHECK((make_compact_stencil_table<std::int64_t, 1>(common).is_valid));
+    }
+
+    return return_code();
+}
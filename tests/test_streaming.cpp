@@ -0,0 +1,71 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/streaming.hpp>
+#include <polysche/stencil.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::StreamingStencil;
+    using polysche::make_stencil;
+    using polysche::apply_stencil;
+
+    // Fourth order centered second derivative
+    constexpr auto PS = PolynomialScheme<4>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-2), P(-1), P(0), P(1), P(2)).solve();
+    constexpr auto D2 = make_stencil(S.derivate(2)(0), -2);
+
+    constexpr std::size_t n = 500;
+    std::vector<double> u(n);
+    for (std::size_t i = 0; i < n; ++i)
+        u[i] = std::sin(0.05 * static_cast<double>(i)) + 1e-3 * static_cast<double>(i * i);
+
+    // Reference: whole array with zeros before the beginning of the stream
+    std::vector<double> padded(n + 4, 0.);
+    std::copy(u.begin(), u.end(), padded.begin() + 2);
+    std::vector<double> expected(n - 2);
+    apply_stencil(D2, padded.data() + 2, n - 2, expected.data());
+
+    for (std::size_t max_chunk : {1, 2, 3, 7, 64, 1000})
+    {
+        StreamingStencil stream(D2);
+        CHECK(stream.latency() == 2);
+
+        std::vector<double> output;
+        std::vector<double> buffer(max_chunk);
+        std::size_t i = 0;
+        for (std::size_t chunk = 1; i < n; chunk = chunk % max_chunk + 1)
+        {
+            std::size_t count = std::min(chunk, n - i);
+            auto written = stream.process(u.data() + i, count, buffer.data());
+            output.insert(output.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(written));
+            i += count;
+        }
+
+        CHECK(output.size() == n - 2);
+        bool ok = output.size() == expected.size();
+        for (std::size_t k = 0; k < output.size() and ok; ++k)
+            ok = std::abs(output[k] - expected[k]) < 1e-12;
+        CHECK(ok);
+    }
+
+    // Causal stencil (backward difference): no latency
+    {
+    StreamingStencil stream(make_stencil(std::array{-1., 1.}, -1));
+    CHECK(stream.latency() == 0);
+    std::array<double, 4> in = {1., 3., 6., 10.};
+    std::array<double, 4> out{};
+    CHECK(stream.process(in.data(), 4, out.data()) == 4);
+    CHECK((out == std::array<double, 4>{1., 2., 3., 4.}));
+    }
+
+    return return_code();
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include <polysche/utility.hpp>
+#include <polysche/rational.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/incremental_scheme.hpp>
+#include <polysche/gauss.hpp>
+#include <polysche/check_inverse.hpp>
+#include <polysche/multistep.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::IncrementalScheme;
+    using polysche::Rational;
+    using R = Rational<long long int>;
+    using polysche::detail::filled_array;
+
+    {
+    constexpr auto A = filled_array<3>(filled_array<2>(R(1, 2)));
+    CHECK(A.size() == 3 and A[2].size() == 2 and A[2][1] == R(1, 2));
+    CHECK(filled_array<0>(1.).size() == 0);
+    }
+
+    {
+    using polysche::detail::checked_mul;
+    constexpr long long int max = std::numeric_limits<long long int>::max();
+    constexpr long long int min = std::numeric_limits<long long int>::min();
+    long long int r = 0;
+    CHECK(checked_mul(-3ll, 7ll, r) and r == -21);
+    CHECK(checked_mul(max, 1ll, r) and r == max);
+    CHECK(checked_mul(min, 1ll, r) and r == min);
+    CHECK(not checked_mul(min, -1ll, r) and r == min);
+    CHECK(not checked_mul(max / 2 + 1, 2ll, r));
+    CHECK(checked_mul(max / 2 + 1, -2ll, r) and r == min);
+    CHECK(not checked_mul(-(max / 2) - 2, 2ll, r));
+    CHECK(not checked_mul(-2ll, -(max / 2) - 1, r));
+
+    std::uint64_t u = 0;
+    CHECK(checked_mul(std::uint64_t(1) << 32, std::uint64_t(1) << 31, u) and u == std::uint64_t(1) << 63);
+    CHECK(not checked_mul(std::uint64_t(1) << 32, std::uint64_t(1) << 32, u));
+    CHECK(checked_mul(std::uint64_t(0), ~std::uint64_t(0), u) and u == 0);
+    }
+
+    // Each function is constant-evaluated first, then evaluated at run time in the same
+    // translation unit (the values being unknown at compile time), see detail::filled_array
+    volatile int zero = 0;
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+
+    {
+    std::cout << "IncrementalScheme:" << std::endl;
+    constexpr auto S = IncrementalScheme<2>{}.add_eqns(P(-1), P(0), P(1)).solve();
+    auto const S_run = IncrementalScheme<2>{}.add_eqns(P(zero - 1), P(zero), P(zero + 1)).solve();
+    CHECK(S_run.coeffs == S.coeffs);
+    }
+
+    {
+    std::cout << "Gauss-Jordan and row replacement:" << std::endl;
+    constexpr auto A = PS.add_eqns(P(-1), P(0), P(1)).matrix;
+    constexpr auto x = polysche::gauss_solve_checked(A, std::array{R(1), R(2), R(4)});
+    constexpr auto inv = polysche::gauss_inv_checked(A);
+    constexpr auto replaced = polysche::inv_replace_row(inv.value, 2, P(2));
+
+    auto const A_run = PS.add_eqns(P(zero - 1), P(zero), P(zero + 1)).matrix;
+    auto const x_run = polysche::gauss_solve_checked(A_run, std::array{R(1), R(2), R(4)});
+    auto const inv_run = polysche::gauss_inv_checked(A_run);
+    CHECK(x_run.is_regular and x_run.value == x.value);
+    CHECK(inv_run.is_regular and inv_run.value == inv.value);
+    CHECK(polysche::inv_replace_row(inv_run.value, 2, P(zero + 2)) == replaced);
+    CHECK(polysche::check_inverse(A_run, inv_run.value));
+    }
+
+    {
+    std::cout << "Multistep coefficients:" << std::endl;
+    constexpr auto nodes = polysche::variable_step_nodes(std::array{R(2), R(1, 2)}, R(1));
+    constexpr auto b = polysche::adams_coefficients(nodes);
+    auto const nodes_run = polysche::variable_step_nodes(std::array{R(zero + 2), R(1, 2)}, R(1));
+    CHECK(nodes_run == nodes);
+    CHECK(polysche::adams_coefficients(nodes_run) == b);
+    }
+
+    return return_code();
+}
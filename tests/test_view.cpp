@@ -0,0 +1,102 @@
+#include <iostream>
+#include <array>
+#include <vector>
+#include <cmath>
+
+#include <polysche/view.hpp>
+#include <polysche/stencil.hpp>
+#include <polysche/polynomial_scheme.hpp>
+#include <polysche/rational.hpp>
+
+#include "utils.hpp"
+
+int main()
+{
+    using polysche::PolynomialScheme;
+    using polysche::make_stencil;
+    using polysche::make_view;
+    using polysche::subview;
+    using polysche::apply_stencil_along;
+
+    constexpr auto PS = PolynomialScheme<2>{};
+    constexpr auto P = PS.get_polynomial();
+    constexpr auto S = PS.add_eqns(P(-1), P(0), P(1)).solve();
+    constexpr auto D = make_stencil(S.derivate()(0), -1);
+
+    // 3D array with one ghost cell on each side
+    constexpr std::size_t nz = 6, ny = 9, nx = 37;
+    std::vector<double> u((nz + 2) * (ny + 2) * (nx + 2));
+    auto full = make_view(u.data(), std::array<std::size_t, 3>{nz + 2, ny + 2, nx + 2});
+    CHECK(full.strides[2] == 1 and full.strides[1] == static_cast<std::ptrdiff_t>(nx + 2));
+
+    auto f = [] (double z, double y, double x) { return z * z * y + 3. * y * y * x - x * x + z; };
+    for (std::size_t k = 0; k < nz + 2; ++k)
+        for (std::size_t j = 0; j < ny + 2; ++j)
+            for (std::size_t i = 0; i < nx + 2; ++i)
+                full(k, j, i) = f(static_cast<double>(k) - 1., static_cast<double>(j) - 1., static_cast<double>(i) - 1.);
+
+    auto interior = subview(full, {1, 1, 1}, {nz, ny, nx});
+    CHECK(interior(0, 0, 0) == f(0., 0., 0.));
+
+    // Exact derivatives of a quadratic function along each axis
+    std::array<std::vector<double>, 3> du;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        du[axis].resize(nz * ny * nx);
+        auto out = make_view(du[axis].data(), std::array<std::size_t, 3>{nz, ny, nx});
+        apply_stencil_along(D, polysche::View<double const, 3>(interior), out, axis, 16);
+    }
+
+    auto dfz = [] (double z, double y, double) { return 2. * z * y + 1.; };
+    auto dfy = [] (double z, double y, double x) { return z * z + 6. * y * x; };
+    auto dfx = [] (double, double y, double x) { return 3. * y * y - 2. * x; };
+
+    bool ok = true;
+    for (std::size_t k = 0; k < nz; ++k)
+        for (std::size_t j = 0; j < ny; ++j)
+            for (std::size_t i = 0; i < nx; ++i)
+            {
+                double z = static_cast<double>(k), y = static_cast<double>(j), x = static_cast<double>(i);
+                std::size_t n = (k * ny + j) * nx + i;
+                ok = ok and std::abs(du[0][n] - dfz(z, y, x)) < 1e-10;
+                ok = ok and std::abs(du[1][n] - dfy(z, y, x)) < 1e-10;
+                ok = ok and std::abs(du[2][n] - dfx(z, y, x)) < 1e-10;
+            }
+    CHECK(ok);
+
+    // Transposed output view (generic strides) gives the same values
+    {
+    std::vector<double> t(nz * ny * nx);
+    auto out = make_view(t.data(), std::array<std::size_t, 3>{nx, ny, nz});
+    polysche::View<double, 3> transposed{out.data, {nz, ny, nx}, {out.strides[2], out.strides[1], out.strides[0]}};
+    apply_stencil_along(D, interior, transposed, 1);
+
+    bool same = true;
+    for (std::size_t k = 0; k < nz; ++k)
+        for (std::size_t j = 0; j < ny; ++j)
+            for (std::size_t i = 0; i < nx; ++i)
+                same = same and std::abs(transposed(k, j, i) - du[1][(k * ny + j) * nx + i]) < 1e-12;
+    CHECK(same);
+    }
+
+    // Fused tensor product application equals the successive applications along each axis
+    {
+    auto const S = make_stencil<double>(std::array{0.25, 0.5, 0.25}, -1);
+    std::vector<double> fused(nz * ny * nx), successive(nz * ny * nx);
+    polysche::apply_stencil_tensor(S, interior, make_view(fused.data(), std::array<std::size_t, 3>{nz, ny, nx}));
+
+    std::vector<double> a(nz * (ny + 2) * (nx + 2)), b(nz * ny * (nx + 2));
+    auto A = make_view(a.data(), std::array<std::size_t, 3>{nz, ny + 2, nx + 2});
+    auto B = make_view(b.data(), std::array<std::size_t, 3>{nz, ny, nx + 2});
+    apply_stencil_along(S, subview(full, {1, 0, 0}, A.extents), A, 0);
+    apply_stencil_along(S, subview(A, {0, 1, 0}, B.extents), B, 1);
+    apply_stencil_along(S, subview(B, {0, 0, 1}, {nz, ny, nx}), make_view(successive.data(), std::array<std::size_t, 3>{nz, ny, nx}), 2);
+
+    bool same = true;
+    for (std::size_t n = 0; n < fused.size(); ++n)
+        same = same and std::abs(fused[n] - successive[n]) < 1e-12;
+    CHECK(same);
+    }
+
+    return return_code();
+}
@@ -5,6 +5,8 @@
 #include <vector>
 #include <algorithm>
 
+#include <polysche/polynomial_scheme.hpp>
+
 namespace std
 {
 
@@ -46,3 +48,21 @@ int return_code()
 
 #define CHECK(expr) check_assertion((expr), __LINE__)
 
+/// Schemes shared by several tests
+namespace schemes
+{
+
+/// Finite volume scheme of the given (even) order on the cells centered at -Order/2, ..., Order/2
+template <std::size_t Order>
+constexpr auto make_finite_volume() noexcept
+{
+    using polysche::PolynomialScheme;
+    auto PS = PolynomialScheme<Order>{};
+    auto P = PS.get_polynomial();
+    for (int i = - static_cast<int>(Order) / 2; i <= static_cast<int>(Order) / 2; ++i)
+        PS.push_eqn(P.integrate({2 * i - 1, 2}, {2 * i + 1, 2}));
+    return PS.solve();
+}
+
+} // namespace schemes
+